@@ -0,0 +1,18 @@
+include(../jacobilib.pri)
+
+TEMPLATE = app
+TARGET = ParallelJacobiMethod
+
+CONFIG += cmdline
+
+SOURCES += \
+        ../src/argumentparser.cpp \
+        ../src/main.cpp
+
+HEADERS += \
+    ../src/argumentparser.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
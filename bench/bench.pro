@@ -0,0 +1,9 @@
+include(../jacobilib.pri)
+
+TEMPLATE = app
+TARGET = jacobibench
+
+CONFIG += cmdline
+
+SOURCES += \
+        jacobibench.cpp
@@ -0,0 +1,115 @@
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "JacobiSolver.h"
+
+/**
+ * @brief Computes the maximum absolute residual |A * x - b| of a row-major system.
+ *
+ * @param a The size * size coefficients, stored row by row.
+ * @param b The right-hand side vector.
+ * @param x The solution to check.
+ * @param size The size of the system.
+ * @return The largest absolute residual over all rows.
+ */
+static double maxResidual(const std::vector<double>& a, const std::vector<double>& b,
+                          const std::vector<double>& x, int size) {
+    double residual = 0.0;
+    for (int i = 0; i < size; ++i) {
+        double sum = 0.0;
+        for (int j = 0; j < size; ++j) {
+            sum += a[size_t(i) * size + j] * x[j];
+        }
+        residual = std::max(residual, std::abs(sum - b[i]));
+    }
+    return residual;
+}
+
+/**
+ * @brief Benchmarks the solver library on a random diagonally dominant system.
+ *
+ * The matrix lives in memory owned by the benchmark and is passed to the solver as a view,
+ * the result is written back into a benchmark-owned buffer. Every storage precision is run
+ * once with and once without the refinement phase.
+ *
+ * Usage: jacobibench [-n <size>] [-e <epsilon>]
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication a(argc, argv);
+
+    int size = 1000;
+    double epsilon = 1e-10;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        QString arg = QString(argv[i]);
+        if (arg == "-n") {
+            size = QString(argv[i + 1]).toInt();
+        } else if (arg == "-e") {
+            epsilon = QString(argv[i + 1]).toDouble();
+        }
+    }
+    if (size <= 0 || epsilon <= 0) {
+        qInfo() << "Usage: jacobibench [-n <size>] [-e <epsilon>]";
+        return -1;
+    }
+
+    std::vector<double> matrix(size_t(size) * size);
+    std::vector<double> b(size);
+    QRandomGenerator random(12345);
+    for (int i = 0; i < size; ++i) {
+        double offDiagonal = 0.0;
+        for (int j = 0; j < size; ++j) {
+            double value = random.generateDouble() * 2.0 - 1.0;
+            matrix[size_t(i) * size + j] = value;
+            if (i != j) offDiagonal += std::abs(value);
+        }
+        matrix[size_t(i) * size + i] = offDiagonal + 1.0;
+        b[i] = random.generateDouble() * 10.0;
+    }
+
+    struct Run {
+        const char* name;
+        JacobiSolver::Precision precision;
+        bool refinement;
+    };
+    const Run runs[] = {
+        {"double", JacobiSolver::Precision::Double, false},
+        {"float", JacobiSolver::Precision::Float, false},
+        {"float+refine", JacobiSolver::Precision::Float, true},
+        {"bf16", JacobiSolver::Precision::BFloat16, false},
+        {"bf16+refine", JacobiSolver::Precision::BFloat16, true},
+    };
+
+    qInfo() << "Size:" << size << "Epsilon:" << epsilon;
+
+    std::vector<double> x(size);
+    for (const Run& run : runs) {
+        JacobiSolver solver(size);
+        solver.setMatrix(MatrixView{matrix.data(), size, size, size});
+        solver.setB(VectorView{b.data(), size});
+        solver.setPrecision(run.precision);
+        solver.setRefinement(run.refinement);
+
+        JacobiSolver::Options options;
+        options.epsilon = epsilon;
+
+        QElapsedTimer timer;
+        timer.start();
+        JacobiSolver::Report report = solver.solve(options);
+        double seconds = timer.elapsed() / 1000.0;
+
+        solver.getResult(x.data());
+
+        qInfo().noquote() << QString("%1: %2 iterations, %3 s, %4 ms/iteration, residual %5")
+                                 .arg(QString(run.name), -13)
+                                 .arg(report.iterations)
+                                 .arg(seconds, 0, 'f', 3)
+                                 .arg(report.iterations ? seconds * 1000.0 / report.iterations : 0.0, 0, 'f', 3)
+                                 .arg(maxResidual(matrix, b, x, size), 0, 'e', 3);
+    }
+
+    return 0;
+}
@@ -0,0 +1,12 @@
+QT += core concurrent
+
+CONFIG += c++17
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+INCLUDEPATH += $$PWD/src
+DEPENDPATH += $$PWD/src
+
+jacobi_shared: DEFINES += JACOBI_SHARED
@@ -0,0 +1,14 @@
+# Links a subproject against the solver library built in ../lib
+include(common.pri)
+
+win32:CONFIG(release, debug|release): JACOBI_LIB_DIR = $$OUT_PWD/../lib/release
+else:win32:CONFIG(debug, debug|release): JACOBI_LIB_DIR = $$OUT_PWD/../lib/debug
+else: JACOBI_LIB_DIR = $$OUT_PWD/../lib
+
+LIBS += -L$$JACOBI_LIB_DIR -ljacobisolver
+
+!jacobi_shared {
+    win32-g++: PRE_TARGETDEPS += $$JACOBI_LIB_DIR/libjacobisolver.a
+    else:win32:!win32-g++: PRE_TARGETDEPS += $$JACOBI_LIB_DIR/jacobisolver.lib
+    else: PRE_TARGETDEPS += $$JACOBI_LIB_DIR/libjacobisolver.a
+}
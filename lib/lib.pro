@@ -0,0 +1,31 @@
+include(../common.pri)
+
+TEMPLATE = lib
+TARGET = jacobisolver
+
+DEFINES += JACOBI_LIBRARY
+
+!jacobi_shared: CONFIG += staticlib
+
+SOURCES += \
+        ../src/batchjacobisolver.cpp \
+        ../src/checkpoint.cpp \
+        ../src/jacobisolver.cpp \
+        ../src/jobpipeline.cpp \
+        ../src/matrixhandler.cpp \
+        ../src/matrixreorderer.cpp \
+        ../src/resultwriter.cpp
+
+HEADERS += \
+    ../src/batchjacobisolver.h \
+    ../src/bfloat16.h \
+    ../src/checkpoint.h \
+    ../src/jacobiglobal.h \
+    ../src/jacobimatrix.h \
+    ../src/jacobisolver.h \
+    ../src/jobpipeline.h \
+    ../src/matrixhandler.h \
+    ../src/matrixreorderer.h \
+    ../src/matrixview.h \
+    ../src/resultwriter.h \
+    ../src/smallsystemkernel.h
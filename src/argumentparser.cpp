@@ -11,7 +11,12 @@
  * @param argv The array of command-line argument strings.
  */
 ArgumentParser::ArgumentParser(int argc, char *argv[])
-    : argc(argc), argv(argv), epsilon(0.0), valid(true)
+    : argc(argc), argv(argv), epsilon(0.0), batch(false),
+      precision(JacobiSolver::Precision::Double), refinement(false),
+      maxIterations(0), timeBudget(0.0),
+      outputFormat(ResultWriter::Format::Text),
+      checkpointInterval(100), reorder(false),
+      parallelJobs(1), parserThreads(1), prefetch(0), valid(true)
 {
 }
 
@@ -19,11 +24,31 @@ ArgumentParser::ArgumentParser(int argc, char *argv[])
 /**
  * @brief Parses the command-line arguments.
  *
- * Recognizes two options:
+ * Recognizes the following options:
  * - `-f <fileName>`: Specifies the input file.
  * - `-e <epsilon>`: Specifies the epsilon value (must be positive).
+ * - `--batch`: The input file contains many small systems separated by empty lines.
+ *   Their solutions are written one after the other, each introduced by a header.
+ * - `-p <double|float|bf16>`: Specifies the storage precision of the coefficients.
+ * - `--refine`: Finishes reduced precision runs with a refinement phase in double.
+ * - `--max-iter <count>`: Limits the number of iterations (must be positive).
+ * - `--time-budget <seconds>`: Limits the wall-clock time of the solve (must be positive).
+ * - `--output <fileName>`: Writes the solution to a file instead of standard output.
+ * - `--format <text|binary>`: Specifies the format of the written solution.
+ * - `--checkpoint <fileName>`: Periodically saves the solver state to a checkpoint file.
+ * - `--checkpoint-every <count>`: Iterations between two checkpoints (default 100, must be positive).
+ * - `--resume <fileName>`: Continues from a checkpoint written for the same system.
+ * - `--reorder`: Applies the Reverse Cuthill-McKee ordering before solving and reports its effect.
+ * - `--jobs <listFile|directory>`: Solves one system per file, listed one per line or all `.txt` files of a directory.
+ *   `--output` then names a directory that receives one result file per job, without it every
+ *   solution on standard output is introduced by a "# job <n> <file>" line.
+ * - `--parallel-jobs <count>`: Jobs solved at the same time in `--jobs` mode (default 1, must be positive).
+ * - `--parser-threads <count>`: Threads loading files ahead of the solver (default 1, must be positive).
+ * - `--prefetch <count>`: Jobs in flight at most (default twice `--parallel-jobs`, must be positive).
  *
  * Validates that required arguments are provided and that epsilon is a valid positive number.
+ * With `--jobs` the input file is not required, and `-f`, `--batch`, `--reorder`, `--checkpoint`
+ * and `--resume` are rejected because they apply to a single input file.
  *
  * @return true if arguments are successfully parsed and valid, false otherwise.
  */
@@ -44,11 +69,116 @@ bool ArgumentParser::parseArguments()
                 return false;
             }
             i++;  // Skipping the next argument because it's the epsilon value
+        } else if (arg == "--batch") {
+            batch = true;
+        } else if (arg == "-p" && i + 1 < argc) {
+            QString name = QString(argv[i + 1]);
+            if (name == "double") {
+                precision = JacobiSolver::Precision::Double;
+            } else if (name == "float") {
+                precision = JacobiSolver::Precision::Float;
+            } else if (name == "bf16") {
+                precision = JacobiSolver::Precision::BFloat16;
+            } else {
+                qDebug() << "Error: Invalid value for precision.";
+                valid = false;
+                return false;
+            }
+            i++;  // Skipping the next argument because it's the precision
+        } else if (arg == "--refine") {
+            refinement = true;
+        } else if (arg == "--max-iter" && i + 1 < argc) {
+            bool maxIterationsOk = false;
+            maxIterations = QString(argv[i + 1]).toInt(&maxIterationsOk);
+            if (!maxIterationsOk || maxIterations <= 0) {
+                qDebug() << "Error: Invalid value for the iteration limit.";
+                valid = false;
+                return false;
+            }
+            i++;  // Skipping the next argument because it's the iteration limit
+        } else if (arg == "--time-budget" && i + 1 < argc) {
+            bool timeBudgetOk = false;
+            timeBudget = QString(argv[i + 1]).toDouble(&timeBudgetOk);
+            if (!timeBudgetOk || timeBudget <= 0) {
+                qDebug() << "Error: Invalid value for the time budget.";
+                valid = false;
+                return false;
+            }
+            i++;  // Skipping the next argument because it's the time budget
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputFileName = QString(argv[i + 1]);
+            i++;  // Skipping the next argument because it's the output file name
+        } else if (arg == "--format" && i + 1 < argc) {
+            QString name = QString(argv[i + 1]);
+            if (name == "text") {
+                outputFormat = ResultWriter::Format::Text;
+            } else if (name == "binary") {
+                outputFormat = ResultWriter::Format::Binary;
+            } else {
+                qDebug() << "Error: Invalid value for the output format.";
+                valid = false;
+                return false;
+            }
+            i++;  // Skipping the next argument because it's the output format
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            checkpointFileName = QString(argv[i + 1]);
+            i++;  // Skipping the next argument because it's the checkpoint file name
+        } else if (arg == "--checkpoint-every" && i + 1 < argc) {
+            bool intervalOk = false;
+            checkpointInterval = QString(argv[i + 1]).toInt(&intervalOk);
+            if (!intervalOk || checkpointInterval <= 0) {
+                qDebug() << "Error: Invalid value for the checkpoint interval.";
+                valid = false;
+                return false;
+            }
+            i++;  // Skipping the next argument because it's the checkpoint interval
+        } else if (arg == "--resume" && i + 1 < argc) {
+            resumeFileName = QString(argv[i + 1]);
+            i++;  // Skipping the next argument because it's the checkpoint file name
+        } else if (arg == "--reorder") {
+            reorder = true;
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            jobsPath = QString(argv[i + 1]);
+            i++;  // Skipping the next argument because it's the job list
+        } else if (arg == "--parallel-jobs" && i + 1 < argc) {
+            bool parallelJobsOk = false;
+            parallelJobs = QString(argv[i + 1]).toInt(&parallelJobsOk);
+            if (!parallelJobsOk || parallelJobs <= 0) {
+                qDebug() << "Error: Invalid value for the number of parallel jobs.";
+                valid = false;
+                return false;
+            }
+            i++;  // Skipping the next argument because it's the number of parallel jobs
+        } else if (arg == "--parser-threads" && i + 1 < argc) {
+            bool parserThreadsOk = false;
+            parserThreads = QString(argv[i + 1]).toInt(&parserThreadsOk);
+            if (!parserThreadsOk || parserThreads <= 0) {
+                qDebug() << "Error: Invalid value for the number of parser threads.";
+                valid = false;
+                return false;
+            }
+            i++;  // Skipping the next argument because it's the number of parser threads
+        } else if (arg == "--prefetch" && i + 1 < argc) {
+            bool prefetchOk = false;
+            prefetch = QString(argv[i + 1]).toInt(&prefetchOk);
+            if (!prefetchOk || prefetch <= 0) {
+                qDebug() << "Error: Invalid value for the prefetch depth.";
+                valid = false;
+                return false;
+            }
+            i++;  // Skipping the next argument because it's the prefetch depth
         }
     }
 
+    if (!jobsPath.isEmpty() && (!fileName.isEmpty() || batch || reorder
+                                || !checkpointFileName.isEmpty() || !resumeFileName.isEmpty())) {
+        qDebug() << "Error: --jobs cannot be combined with -f, --batch, --reorder, --checkpoint or --resume.";
+        valid = false;
+        return false;
+    }
+
     // CHeck if the arguments are complete and valid
-    if (fileName.isEmpty() || epsilon == 0.0) {
+    if ((fileName.isEmpty() && jobsPath.isEmpty()) || epsilon == 0.0) {
         qDebug() << "Error: No file or epsilon specified.";
         valid = false;
         return false;
@@ -80,6 +210,171 @@ double ArgumentParser::getEpsilon() const
 }
 
 
+/**
+ * @brief Checks if the input file should be solved as a batch of small systems.
+ *
+ * @return true if the `--batch` option was given, false otherwise.
+ */
+bool ArgumentParser::isBatch() const
+{
+    return batch;
+}
+
+
+/**
+ * @brief Gets the parsed storage precision of the coefficients.
+ *
+ * @return The precision, JacobiSolver::Precision::Double if `-p` was not given.
+ */
+JacobiSolver::Precision ArgumentParser::getPrecision() const
+{
+    return precision;
+}
+
+
+/**
+ * @brief Checks if a refinement phase in double precision was requested.
+ *
+ * @return true if the `--refine` option was given, false otherwise.
+ */
+bool ArgumentParser::isRefinement() const
+{
+    return refinement;
+}
+
+
+/**
+ * @brief Gets the parsed iteration limit.
+ *
+ * @return The maximum number of iterations, 0 if `--max-iter` was not given.
+ */
+int ArgumentParser::getMaxIterations() const
+{
+    return maxIterations;
+}
+
+
+/**
+ * @brief Gets the parsed wall-clock budget.
+ *
+ * @return The budget in seconds, 0 if `--time-budget` was not given.
+ */
+double ArgumentParser::getTimeBudget() const
+{
+    return timeBudget;
+}
+
+
+/**
+ * @brief Gets the parsed output file name.
+ *
+ * @return The output file name, empty for standard output.
+ */
+QString ArgumentParser::getOutputFileName() const
+{
+    return outputFileName;
+}
+
+
+/**
+ * @brief Gets the parsed output format.
+ *
+ * @return The output format, ResultWriter::Format::Text if `--format` was not given.
+ */
+ResultWriter::Format ArgumentParser::getOutputFormat() const
+{
+    return outputFormat;
+}
+
+
+/**
+ * @brief Gets the parsed checkpoint file name.
+ *
+ * @return The checkpoint file name, empty if `--checkpoint` was not given.
+ */
+QString ArgumentParser::getCheckpointFileName() const
+{
+    return checkpointFileName;
+}
+
+
+/**
+ * @brief Gets the parsed number of iterations between checkpoints.
+ *
+ * @return The checkpoint interval, 100 if `--checkpoint-every` was not given.
+ */
+int ArgumentParser::getCheckpointInterval() const
+{
+    return checkpointInterval;
+}
+
+
+/**
+ * @brief Gets the parsed name of the checkpoint to resume from.
+ *
+ * @return The checkpoint file name, empty if `--resume` was not given.
+ */
+QString ArgumentParser::getResumeFileName() const
+{
+    return resumeFileName;
+}
+
+
+/**
+ * @brief Checks if the system should be reordered before solving.
+ *
+ * @return true if the `--reorder` option was given, false otherwise.
+ */
+bool ArgumentParser::isReorder() const
+{
+    return reorder;
+}
+
+
+/**
+ * @brief Gets the parsed job list file or job directory.
+ *
+ * @return The job list or directory, empty if `--jobs` was not given.
+ */
+QString ArgumentParser::getJobsPath() const
+{
+    return jobsPath;
+}
+
+
+/**
+ * @brief Gets the parsed number of jobs solved at the same time.
+ *
+ * @return The number of concurrent jobs, 1 if `--parallel-jobs` was not given.
+ */
+int ArgumentParser::getParallelJobs() const
+{
+    return parallelJobs;
+}
+
+
+/**
+ * @brief Gets the parsed number of threads loading job files.
+ *
+ * @return The number of parser threads, 1 if `--parser-threads` was not given.
+ */
+int ArgumentParser::getParserThreads() const
+{
+    return parserThreads;
+}
+
+
+/**
+ * @brief Gets the parsed maximum number of jobs in flight.
+ *
+ * @return The prefetch depth, 0 for the default if `--prefetch` was not given.
+ */
+int ArgumentParser::getPrefetch() const
+{
+    return prefetch;
+}
+
+
 /**
  * @brief Checks if the parsed arguments are valid.
  *
@@ -4,6 +4,8 @@
 #include <QString>
 #include <QStringList>
 #include <QDebug>
+#include "JacobiSolver.h"
+#include "ResultWriter.h"
 
 
 /**
@@ -32,11 +34,31 @@ public:
     /**
      * @brief Parses the command-line arguments.
      *
-     * Recognizes two options:
+     * Recognizes the following options:
      * - `-f <fileName>`: Specifies the input file.
      * - `-e <epsilon>`: Specifies the epsilon value (must be positive).
+     * - `--batch`: The input file contains many small systems separated by empty lines.
+     *   Their solutions are written one after the other, each introduced by a header.
+     * - `-p <double|float|bf16>`: Specifies the storage precision of the coefficients.
+     * - `--refine`: Finishes reduced precision runs with a refinement phase in double.
+     * - `--max-iter <count>`: Limits the number of iterations (must be positive).
+     * - `--time-budget <seconds>`: Limits the wall-clock time of the solve (must be positive).
+     * - `--output <fileName>`: Writes the solution to a file instead of standard output.
+     * - `--format <text|binary>`: Specifies the format of the written solution.
+     * - `--checkpoint <fileName>`: Periodically saves the solver state to a checkpoint file.
+     * - `--checkpoint-every <count>`: Iterations between two checkpoints (default 100, must be positive).
+     * - `--resume <fileName>`: Continues from a checkpoint written for the same system.
+     * - `--reorder`: Applies the Reverse Cuthill-McKee ordering before solving and reports its effect.
+     * - `--jobs <listFile|directory>`: Solves one system per file, listed one per line or all `.txt` files of a directory.
+     *   `--output` then names a directory that receives one result file per job, without it every
+     *   solution on standard output is introduced by a "# job <n> <file>" line.
+     * - `--parallel-jobs <count>`: Jobs solved at the same time in `--jobs` mode (default 1, must be positive).
+     * - `--parser-threads <count>`: Threads loading files ahead of the solver (default 1, must be positive).
+     * - `--prefetch <count>`: Jobs in flight at most (default twice `--parallel-jobs`, must be positive).
      *
      * Validates that required arguments are provided and that epsilon is a valid positive number.
+     * With `--jobs` the input file is not required, and `-f`, `--batch`, `--reorder`, `--checkpoint`
+     * and `--resume` are rejected because they apply to a single input file.
      *
      * @return true if arguments are successfully parsed and valid, false otherwise.
      */
@@ -59,6 +81,126 @@ public:
     double getEpsilon() const;
 
 
+    /**
+     * @brief Checks if the input file should be solved as a batch of small systems.
+     *
+     * @return true if the `--batch` option was given, false otherwise.
+     */
+    bool isBatch() const;
+
+
+    /**
+     * @brief Gets the parsed storage precision of the coefficients.
+     *
+     * @return The precision, JacobiSolver::Precision::Double if `-p` was not given.
+     */
+    JacobiSolver::Precision getPrecision() const;
+
+
+    /**
+     * @brief Checks if a refinement phase in double precision was requested.
+     *
+     * @return true if the `--refine` option was given, false otherwise.
+     */
+    bool isRefinement() const;
+
+
+    /**
+     * @brief Gets the parsed iteration limit.
+     *
+     * @return The maximum number of iterations, 0 if `--max-iter` was not given.
+     */
+    int getMaxIterations() const;
+
+
+    /**
+     * @brief Gets the parsed wall-clock budget.
+     *
+     * @return The budget in seconds, 0 if `--time-budget` was not given.
+     */
+    double getTimeBudget() const;
+
+
+    /**
+     * @brief Gets the parsed output file name.
+     *
+     * @return The output file name, empty for standard output.
+     */
+    QString getOutputFileName() const;
+
+
+    /**
+     * @brief Gets the parsed output format.
+     *
+     * @return The output format, ResultWriter::Format::Text if `--format` was not given.
+     */
+    ResultWriter::Format getOutputFormat() const;
+
+
+    /**
+     * @brief Gets the parsed checkpoint file name.
+     *
+     * @return The checkpoint file name, empty if `--checkpoint` was not given.
+     */
+    QString getCheckpointFileName() const;
+
+
+    /**
+     * @brief Gets the parsed number of iterations between checkpoints.
+     *
+     * @return The checkpoint interval, 100 if `--checkpoint-every` was not given.
+     */
+    int getCheckpointInterval() const;
+
+
+    /**
+     * @brief Gets the parsed name of the checkpoint to resume from.
+     *
+     * @return The checkpoint file name, empty if `--resume` was not given.
+     */
+    QString getResumeFileName() const;
+
+
+    /**
+     * @brief Checks if the system should be reordered before solving.
+     *
+     * @return true if the `--reorder` option was given, false otherwise.
+     */
+    bool isReorder() const;
+
+
+    /**
+     * @brief Gets the parsed job list file or job directory.
+     *
+     * @return The job list or directory, empty if `--jobs` was not given.
+     */
+    QString getJobsPath() const;
+
+
+    /**
+     * @brief Gets the parsed number of jobs solved at the same time.
+     *
+     * @return The number of concurrent jobs, 1 if `--parallel-jobs` was not given.
+     */
+    int getParallelJobs() const;
+
+
+    /**
+     * @brief Gets the parsed number of threads loading job files.
+     *
+     * @return The number of parser threads, 1 if `--parser-threads` was not given.
+     */
+    int getParserThreads() const;
+
+
+    /**
+     * @brief Gets the parsed maximum number of jobs in flight.
+     *
+     * @return The prefetch depth, 0 for the default if `--prefetch` was not given.
+     */
+    int getPrefetch() const;
+
+
     /**
      * @brief Checks if the parsed arguments are valid.
      *
@@ -71,6 +213,21 @@ private:
     char **argv;
     QString fileName;
     double epsilon;
+    bool batch;
+    JacobiSolver::Precision precision;
+    bool refinement;
+    int maxIterations;
+    double timeBudget;
+    QString outputFileName;
+    ResultWriter::Format outputFormat;
+    QString checkpointFileName;
+    int checkpointInterval;
+    QString resumeFileName;
+    bool reorder;
+    QString jobsPath;
+    int parallelJobs;
+    int parserThreads;
+    int prefetch;
     bool valid;
 };
 
@@ -0,0 +1,257 @@
+#include "BatchJacobiSolver.h"
+#include "SmallSystemKernel.h"
+#include <QDebug>
+#include <QLoggingCategory>
+#include <QMap>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+using SmallSystemKernel::Lanes;
+
+namespace {
+
+Q_LOGGING_CATEGORY(lcBatch, "jacobi.batch", QtInfoMsg)
+
+/**
+ * @brief Checks that a system is square, matches its right-hand side and has no zero on the diagonal.
+ */
+bool isSolvable(const QVector<QVector<double>>& m, const QVector<double>& v) {
+    if (m.isEmpty() || v.size() != m.size()) return false;
+    for (int r = 0; r < m.size(); ++r) {
+        if (m[r].size() != m.size() || qFuzzyIsNull(m[r][r])) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @class BatchJacobiSolver
+ * @brief A class to solve many small independent systems of linear equations using the Jacobi method.
+ *
+ * Systems of the same size are packed into groups of SmallSystemKernel::Lanes systems. Every
+ * group is solved by one thread with a kernel specialized at compile time for its size.
+ */
+
+/**
+ * @brief Constructs an empty BatchJacobiSolver object.
+ */
+BatchJacobiSolver::BatchJacobiSolver() {}
+
+/**
+ * @brief Adds a system to the batch.
+ *
+ * @param m The square matrix of coefficients of the system.
+ * @param rhs The right-hand side vector of the system.
+ * @return The index of the system within the batch.
+ */
+int BatchJacobiSolver::addSystem(const QVector<QVector<double>>& m, const QVector<double>& rhs) {
+    matrices.append(m);
+    this->rhs.append(rhs);
+    return matrices.size() - 1;
+}
+
+/**
+ * @brief Moves a system into the batch.
+ *
+ * @param m The square matrix of coefficients of the system.
+ * @param rhs The right-hand side vector of the system.
+ * @return The index of the system within the batch.
+ */
+int BatchJacobiSolver::addSystem(QVector<QVector<double>>&& m, QVector<double>&& rhs) {
+    matrices.append(std::move(m));
+    this->rhs.append(std::move(rhs));
+    return matrices.size() - 1;
+}
+
+/**
+ * @brief Gets the number of systems in the batch.
+ *
+ * @return The number of systems added so far.
+ */
+int BatchJacobiSolver::systemCount() const {
+    return matrices.size();
+}
+
+/**
+ * @brief Groups the systems by size and packs them into structure of arrays storage.
+ *
+ * Every row is divided by its diagonal element and the diagonal is set to zero, so the
+ * kernels compute xNew = b - A * xOld. Unused lanes of the last pack of every size stay
+ * zero and converge immediately. Systems that cannot be solved are left out of the packs.
+ *
+ * @param solvable Receives for every system whether it was packed.
+ * @return The packs covering all solvable systems of the batch.
+ */
+QVector<BatchJacobiSolver::SystemPack> BatchJacobiSolver::buildPacks(QVector<bool>& solvable) const {
+    QMap<int, QVector<int>> systemsBySize;
+    solvable.resize(matrices.size());
+    for (int s = 0; s < matrices.size(); ++s) {
+        solvable[s] = isSolvable(matrices[s], rhs[s]);
+        if (solvable[s]) {
+            systemsBySize[matrices[s].size()].append(s);
+        } else {
+            qCWarning(lcBatch) << "Error: System" << s + 1 << "is not square or has a zero on the diagonal.";
+        }
+    }
+
+    QVector<SystemPack> packs;
+    for (auto it = systemsBySize.constBegin(); it != systemsBySize.constEnd(); ++it) {
+        const int n = it.key();
+        const QVector<int>& systems = it.value();
+
+        for (int first = 0; first < systems.size(); first += Lanes) {
+            SystemPack pack;
+            pack.size = n;
+            pack.systems = systems.mid(first, Lanes);
+            pack.a.resize(n * n * Lanes, 0.0);
+            pack.b.resize(n * Lanes, 0.0);
+            pack.x.resize(n * Lanes, 0.0);
+            pack.iterations.resize(Lanes, 0);
+            pack.converged.resize(Lanes, false);
+
+            for (int l = 0; l < pack.systems.size(); ++l) {
+                const QVector<QVector<double>>& m = matrices[pack.systems[l]];
+                const QVector<double>& v = rhs[pack.systems[l]];
+
+                for (int r = 0; r < n; ++r) {
+                    double diag = m[r][r];
+                    for (int c = 0; c < n; ++c) {
+                        if (r != c) {
+                            pack.a[(r * n + c) * Lanes + l] = m[r][c] / diag;
+                        }
+                    }
+                    pack.b[r * Lanes + l] = v[r] / diag;
+                }
+            }
+            packs.append(pack);
+        }
+    }
+    return packs;
+}
+
+/**
+ * @brief Iterates one pack until all of its systems converge.
+ *
+ * Lanes that have already converged keep being updated together with the rest of the pack,
+ * which only moves them closer to the fixed point and keeps the kernel free of branches.
+ * The deadline is checked between sweeps.
+ *
+ * @param pack The pack to solve.
+ * @param epsilon The convergence threshold (stopping criterion).
+ * @param maxIterations The maximum number of iterations.
+ * @param deadline The end of the time budget of the batch.
+ */
+void BatchJacobiSolver::solvePack(SystemPack& pack, double epsilon, int maxIterations,
+                                  const QDeadlineTimer& deadline) {
+    const int n = pack.size;
+    const int usedLanes = pack.systems.size();
+    SmallSystemKernel::SweepFunction sweep = SmallSystemKernel::sweepFor(n);
+
+    QVector<double> xNew(pack.x.size(), 0.0);
+    int pending = usedLanes;
+
+    for (int iteration = 1; iteration <= maxIterations && pending > 0 && !deadline.hasExpired(); ++iteration) {
+        sweep(n, pack.a.constData(), pack.b.constData(), pack.x.constData(), xNew.data());
+
+        double maxChange[Lanes] = {};
+        for (int i = 0; i < n; ++i) {
+            for (int l = 0; l < Lanes; ++l) {
+                maxChange[l] = std::max(maxChange[l], std::abs(xNew[i * Lanes + l] - pack.x[i * Lanes + l]));
+            }
+        }
+
+        std::swap(pack.x, xNew);
+
+        for (int l = 0; l < usedLanes; ++l) {
+            if (!pack.converged[l]) {
+                pack.iterations[l] = iteration;
+                if (maxChange[l] < epsilon) {
+                    pack.converged[l] = true;
+                    pending--;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Solves all systems in the batch.
+ *
+ * The packs are distributed over the global thread pool, one pack per task.
+ * Packs that have not started when the time budget runs out stop right away.
+ *
+ * @param epsilon The convergence threshold (stopping criterion).
+ * @param maxIterations The maximum number of iterations per system.
+ * @param timeBudget The wall-clock budget of the whole batch in seconds, 0 for no limit.
+ */
+void BatchJacobiSolver::solve(double epsilon, int maxIterations, double timeBudget) {
+    const QDeadlineTimer deadline = timeBudget > 0.0 ? QDeadlineTimer(qint64(timeBudget * 1000.0))
+                                                     : QDeadlineTimer(QDeadlineTimer::Forever);
+    QVector<SystemPack> packs = buildPacks(valid);
+
+    QtConcurrent::blockingMap(packs, [epsilon, maxIterations, &deadline](SystemPack& pack) {
+        solvePack(pack, epsilon, maxIterations, deadline);
+    });
+
+    // Systems left out of the packs keep an empty result, no iterations and are not converged
+    results.fill(QVector<double>(), matrices.size());
+    iterations.fill(0, matrices.size());
+    converged.fill(false, matrices.size());
+
+    for (const SystemPack& pack : packs) {
+        for (int l = 0; l < pack.systems.size(); ++l) {
+            const int s = pack.systems[l];
+            QVector<double> x(pack.size);
+            for (int i = 0; i < pack.size; ++i) {
+                x[i] = pack.x[i * Lanes + l];
+            }
+            results[s] = x;
+            iterations[s] = pack.iterations[l];
+            converged[s] = pack.converged[l];
+        }
+    }
+
+    qCDebug(lcBatch) << "Solved" << matrices.size() << "systems in" << packs.size() << "packs";
+}
+
+/**
+ * @brief Gets the solution of one system.
+ *
+ * @param index The index of the system returned by addSystem().
+ * @return The solution vector.
+ */
+QVector<double> BatchJacobiSolver::getResult(int index) const {
+    return results.value(index);
+}
+
+/**
+ * @brief Gets the number of iterations one system needed to converge.
+ *
+ * @param index The index of the system returned by addSystem().
+ * @return The number of iterations performed for the system.
+ */
+int BatchJacobiSolver::getIterations(int index) const {
+    return iterations.value(index);
+}
+
+/**
+ * @brief Checks if one system converged within the iteration limit.
+ *
+ * @param index The index of the system returned by addSystem().
+ * @return true if the system converged, false otherwise.
+ */
+bool BatchJacobiSolver::hasConverged(int index) const {
+    return converged.value(index);
+}
+
+/**
+ * @brief Checks if one system could be solved.
+ *
+ * @param index The index of the system returned by addSystem().
+ * @return false if the last solve() left the system out, true otherwise.
+ */
+bool BatchJacobiSolver::isValid(int index) const {
+    return valid.value(index, true);
+}
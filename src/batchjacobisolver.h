@@ -0,0 +1,139 @@
+#ifndef BATCHJACOBISOLVER_H
+#define BATCHJACOBISOLVER_H
+
+#include <QDeadlineTimer>
+#include <QVector>
+#include "JacobiGlobal.h"
+
+/**
+ * @class BatchJacobiSolver
+ * @brief A class for solving many small independent linear systems using the Jacobi method.
+ *
+ * Systems of the same size are packed together in a structure of arrays layout so that one
+ * kernel call performs a Jacobi sweep for several systems at once. Every pack is solved by a
+ * single thread from start to finish, so there is no synchronization between iterations.
+ */
+class JACOBI_EXPORT BatchJacobiSolver
+{
+public:
+    /**
+     * @brief Constructs an empty BatchJacobiSolver object.
+     */
+    BatchJacobiSolver();
+
+    /**
+     * @brief Adds a system to the batch.
+     *
+     * @param m The square matrix of coefficients of the system.
+     * @param rhs The right-hand side vector of the system.
+     * @return The index of the system within the batch.
+     */
+    int addSystem(const QVector<QVector<double>>& m, const QVector<double>& rhs);
+
+    /**
+     * @brief Moves a system into the batch.
+     *
+     * @param m The square matrix of coefficients of the system.
+     * @param rhs The right-hand side vector of the system.
+     * @return The index of the system within the batch.
+     */
+    int addSystem(QVector<QVector<double>>&& m, QVector<double>&& rhs);
+
+    /**
+     * @brief Gets the number of systems in the batch.
+     *
+     * @return The number of systems added so far.
+     */
+    int systemCount() const;
+
+    /**
+     * @brief Solves all systems in the batch.
+     *
+     * Every system is iterated until the maximum change in its solution vector is less than
+     * epsilon, or until the iteration limit is reached or the time budget runs out.
+     *
+     * @param epsilon The convergence threshold (stopping criterion).
+     * @param maxIterations The maximum number of iterations per system.
+     * @param timeBudget The wall-clock budget of the whole batch in seconds, 0 for no limit.
+     */
+    void solve(double epsilon, int maxIterations = 10000, double timeBudget = 0.0);
+
+    /**
+     * @brief Gets the solution of one system.
+     *
+     * @param index The index of the system returned by addSystem().
+     * @return A QVector<double> containing the solution of the system.
+     */
+    QVector<double> getResult(int index) const;
+
+    /**
+     * @brief Gets the number of iterations one system needed to converge.
+     *
+     * @param index The index of the system returned by addSystem().
+     * @return The number of iterations performed for the system.
+     */
+    int getIterations(int index) const;
+
+    /**
+     * @brief Checks if one system converged within the iteration limit.
+     *
+     * @param index The index of the system returned by addSystem().
+     * @return true if the system converged, false otherwise.
+     */
+    bool hasConverged(int index) const;
+
+    /**
+     * @brief Checks if one system could be solved.
+     *
+     * Systems that are not square, do not match their right-hand side or have a zero on the
+     * diagonal are skipped by solve() instead of stopping the whole batch.
+     *
+     * @param index The index of the system returned by addSystem().
+     * @return false if the last solve() left the system out, true otherwise.
+     */
+    bool isValid(int index) const;
+
+private:
+    /**
+     * @struct SystemPack
+     * @brief Up to SmallSystemKernel::Lanes systems of the same size in structure of arrays layout.
+     */
+    struct SystemPack {
+        int size = 0;  ///< The size of every system in the pack.
+        QVector<int> systems;  ///< Batch indices of the systems stored in the lanes.
+        QVector<double> a;  ///< Normalized coefficients, interleaved by lane.
+        QVector<double> b;  ///< Normalized right-hand sides, interleaved by lane.
+        QVector<double> x;  ///< Current approximations, interleaved by lane.
+        QVector<int> iterations;  ///< Iterations needed by every lane to converge.
+        QVector<bool> converged;  ///< Whether every lane converged.
+    };
+
+    QVector<QVector<QVector<double>>> matrices;  ///< The matrices of the systems.
+    QVector<QVector<double>> rhs;  ///< The right-hand side vectors of the systems.
+    QVector<QVector<double>> results;  ///< The solutions of the systems.
+    QVector<int> iterations;  ///< The number of iterations performed for every system.
+    QVector<bool> converged;  ///< Whether every system converged.
+    QVector<bool> valid;  ///< Whether every system could be packed by the last solve().
+
+    /**
+     * @brief Groups the systems by size and packs them into structure of arrays storage.
+     *
+     * The coefficients are normalized while packing, the same way JacobiSolver does it.
+     *
+     * @param solvable Receives for every system whether it was packed.
+     * @return The packs covering all solvable systems of the batch.
+     */
+    QVector<SystemPack> buildPacks(QVector<bool>& solvable) const;
+
+    /**
+     * @brief Iterates one pack until all of its systems converge.
+     *
+     * @param pack The pack to solve.
+     * @param epsilon The convergence threshold (stopping criterion).
+     * @param maxIterations The maximum number of iterations.
+     * @param deadline The end of the time budget of the batch.
+     */
+    static void solvePack(SystemPack& pack, double epsilon, int maxIterations, const QDeadlineTimer& deadline);
+};
+
+#endif // BATCHJACOBISOLVER_H
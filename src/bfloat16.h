@@ -0,0 +1,50 @@
+#ifndef BFLOAT16_H
+#define BFLOAT16_H
+
+#include <QtGlobal>
+#include <cstring>
+
+/**
+ * @struct BFloat16
+ * @brief A 16-bit brain floating point number used for compact matrix storage.
+ *
+ * The value keeps the sign, the 8-bit exponent and the upper 7 bits of the mantissa of a float,
+ * so it has the range of a float with roughly three significant decimal digits. Conversions
+ * from float round to the nearest even value.
+ */
+struct BFloat16
+{
+    quint16 bits = 0;  ///< The upper half of the IEEE 754 single precision representation.
+
+    BFloat16() = default;
+
+    /**
+     * @brief Converts a float to BFloat16 with round to nearest even.
+     *
+     * @param value The value to convert.
+     */
+    BFloat16(float value)
+    {
+        quint32 u;
+        std::memcpy(&u, &value, sizeof(u));
+        if ((u & 0x7fffffffu) > 0x7f800000u) {
+            bits = quint16((u >> 16) | 0x0040u);  // Keep NaN a (quiet) NaN
+        } else {
+            u += 0x7fffu + ((u >> 16) & 1u);
+            bits = quint16(u >> 16);
+        }
+    }
+
+    /**
+     * @brief Converts the value back to float, which is exact.
+     */
+    operator float() const
+    {
+        quint32 u = quint32(bits) << 16;
+        float value;
+        std::memcpy(&value, &u, sizeof(value));
+        return value;
+    }
+};
+
+#endif // BFLOAT16_H
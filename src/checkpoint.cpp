@@ -0,0 +1,214 @@
+#include "Checkpoint.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace {
+
+constexpr quint32 CheckpointMagic = 0x4A434B50;  ///< "JCKP"
+constexpr quint32 CheckpointVersion = 2;  ///< Version 2 added the refinement phase flag.
+constexpr quint64 FnvOffset = 14695981039346656037ULL;
+constexpr quint64 FnvPrime = 1099511628211ULL;
+
+/**
+ * @brief Hashes a range of doubles with 64-bit FNV-1a applied to whole words.
+ */
+quint64 hashValues(quint64 hash, const double* values, int count) {
+    for (int i = 0; i < count; ++i) {
+        quint64 bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        hash = (hash ^ bits) * FnvPrime;
+    }
+    return hash;
+}
+
+} // namespace
+
+/**
+ * @brief Writes the checkpoint to a file.
+ *
+ * @param fileName The name of the checkpoint file.
+ * @return true if the checkpoint was written, false otherwise.
+ */
+bool Checkpoint::save(const QString& fileName) const {
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Error: Unable to open the checkpoint file.";
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << CheckpointMagic << CheckpointVersion << systemHash << qint32(iteration) << residual << refining
+        << history << x;
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qDebug() << "Error: Unable to write the checkpoint file.";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a checkpoint from a file.
+ *
+ * @param fileName The name of the checkpoint file.
+ * @param checkpoint Reference to the checkpoint that receives the state.
+ * @return true if the file is a valid checkpoint, false otherwise.
+ */
+bool Checkpoint::load(const QString& fileName, Checkpoint& checkpoint) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Error: Unable to open the checkpoint file.";
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != CheckpointMagic || version < 1 || version > CheckpointVersion) {
+        qDebug() << "Error: The file is not a supported checkpoint.";
+        return false;
+    }
+
+    qint32 iteration = 0;
+    in >> checkpoint.systemHash >> iteration >> checkpoint.residual;
+    checkpoint.refining = false;
+    if (version >= 2) {
+        in >> checkpoint.refining;
+    }
+    in >> checkpoint.history >> checkpoint.x;
+    checkpoint.iteration = iteration;
+
+    if (in.status() != QDataStream::Ok) {
+        qDebug() << "Error: The checkpoint file is truncated or corrupted.";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Computes a 64-bit hash of a system, used to match checkpoints with their input.
+ *
+ * @param matrix The matrix of coefficients.
+ * @param b The right-hand side vector.
+ * @return The hash of the system.
+ */
+quint64 Checkpoint::hashSystem(const MatrixView& matrix, const VectorView& b) {
+    QVector<int> rows(matrix.rows);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    QVector<quint64> rowHashes = QtConcurrent::blockingMapped<QVector<quint64>>(rows, [&matrix](int r) {
+        return hashValues(FnvOffset, matrix.row(r), matrix.cols);
+    });
+
+    quint64 hash = FnvOffset;
+    hash = (hash ^ quint64(matrix.rows)) * FnvPrime;
+    hash = (hash ^ quint64(matrix.cols)) * FnvPrime;
+    for (quint64 rowHash : rowHashes) {
+        hash = (hash ^ rowHash) * FnvPrime;
+    }
+    return hashValues(hash, b.data, b.size);
+}
+
+/**
+ * @brief Constructs a disabled CheckpointWriter.
+ */
+CheckpointWriter::CheckpointWriter() : interval(0) {
+    pool.setMaxThreadCount(1);
+}
+
+/**
+ * @brief Destructor, waits for the checkpoint being written.
+ */
+CheckpointWriter::~CheckpointWriter() {
+    waitForFinished();
+}
+
+/**
+ * @brief Sets the checkpoint file and the number of iterations between checkpoints.
+ *
+ * @param fileName The name of the checkpoint file, empty to disable checkpoints.
+ * @param interval The number of iterations between two checkpoints.
+ */
+void CheckpointWriter::setFile(const QString& fileName, int interval) {
+    waitForFinished();
+    this->fileName = fileName;
+    this->interval = interval;
+}
+
+/**
+ * @brief Checks if checkpoints are enabled.
+ */
+bool CheckpointWriter::isEnabled() const {
+    return !fileName.isEmpty() && interval > 0;
+}
+
+/**
+ * @brief Checks if a checkpoint is due after the given iteration.
+ */
+bool CheckpointWriter::isDue(int iteration) const {
+    return isEnabled() && iteration % interval == 0;
+}
+
+/**
+ * @brief Forgets the history of the previous computation.
+ *
+ * Must be called when the history passed to submit() was cleared or replaced, so the next
+ * checkpoint copies it in full.
+ */
+void CheckpointWriter::restart() {
+    waitForFinished();
+    snapshot.history.clear();
+}
+
+/**
+ * @brief Starts writing a checkpoint in the background, unless a write is still running.
+ *
+ * The iterate and the history entries added since the last checkpoint are copied into the
+ * snapshot in the calling thread, everything else happens in the writer's own thread, so the
+ * caller can continue modifying its own vectors right away. The copy costs O(size + interval)
+ * rather than growing with the number of iterations.
+ *
+ * @param state The state to write, its x and history are ignored in favour of the parameters.
+ * @param x Pointer to the current approximation of the solution.
+ * @param size The number of unknowns.
+ * @param history The convergence history, only grown by appending since restart().
+ * @return true if the checkpoint was started, false if it was skipped.
+ */
+bool CheckpointWriter::submit(const Checkpoint& state, const double* x, int size, const QVector<double>& history) {
+    if (!isEnabled() || !pending.isFinished()) {
+        return false;
+    }
+
+    snapshot.systemHash = state.systemHash;
+    snapshot.iteration = state.iteration;
+    snapshot.residual = state.residual;
+    snapshot.refining = state.refining;
+    // The entries up to known are already in the snapshot, unless the history shrank since
+    const qsizetype known = snapshot.history.size() <= history.size() ? snapshot.history.size() : 0;
+    snapshot.history.resize(history.size());
+    std::copy(history.cbegin() + known, history.cend(), snapshot.history.begin() + known);
+    snapshot.x.resize(size);
+    std::copy(x, x + size, snapshot.x.begin());
+
+    pending = QtConcurrent::run(&pool, [this]() {
+        snapshot.save(fileName);
+    });
+    return true;
+}
+
+/**
+ * @brief Waits for the checkpoint being written, if any.
+ */
+void CheckpointWriter::waitForFinished() {
+    pending.waitForFinished();
+}
@@ -0,0 +1,129 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <QFuture>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include "JacobiGlobal.h"
+#include "MatrixView.h"
+
+/**
+ * @struct Checkpoint
+ * @brief The state of a Jacobi solve that is needed to continue it later.
+ *
+ * Checkpoints are written with QDataStream through QSaveFile, so an interrupted write never
+ * replaces the previous checkpoint with a truncated one.
+ */
+struct JACOBI_EXPORT Checkpoint
+{
+    quint64 systemHash = 0;  ///< Hash of the matrix and the right-hand side the state belongs to.
+    int iteration = 0;  ///< The number of iterations performed.
+    double residual = 0.0;  ///< The maximum change of the last iteration.
+    bool refining = false;  ///< Whether the state belongs to the refinement phase in double precision.
+    QVector<double> history;  ///< The maximum change of every iteration.
+    QVector<double> x;  ///< The current approximation of the solution.
+
+    /**
+     * @brief Writes the checkpoint to a file.
+     *
+     * @param fileName The name of the checkpoint file.
+     * @return true if the checkpoint was written, false otherwise.
+     */
+    bool save(const QString& fileName) const;
+
+    /**
+     * @brief Reads a checkpoint from a file.
+     *
+     * @param fileName The name of the checkpoint file.
+     * @param checkpoint Reference to the checkpoint that receives the state.
+     * @return true if the file is a valid checkpoint, false otherwise.
+     */
+    static bool load(const QString& fileName, Checkpoint& checkpoint);
+
+    /**
+     * @brief Computes a 64-bit hash of a system, used to match checkpoints with their input.
+     *
+     * The rows are hashed in parallel and the row hashes are combined in order.
+     *
+     * @param matrix The matrix of coefficients.
+     * @param b The right-hand side vector.
+     * @return The hash of the system.
+     */
+    static quint64 hashSystem(const MatrixView& matrix, const VectorView& b);
+};
+
+/**
+ * @class CheckpointWriter
+ * @brief A class for writing checkpoints in the background.
+ *
+ * submit() copies the iterate into a snapshot buffer and hands it to a private single-thread pool,
+ * so the solver only pays for one vector copy and the writes never occupy the threads of the
+ * global pool that run the sweeps. The snapshot keeps the convergence history between
+ * checkpoints and only the entries added since the last one are copied. If the previous
+ * checkpoint is still being written, the new one is skipped instead of making the solver wait.
+ */
+class JACOBI_EXPORT CheckpointWriter
+{
+public:
+    /**
+     * @brief Constructs a disabled CheckpointWriter.
+     */
+    CheckpointWriter();
+
+    /**
+     * @brief Destructor, waits for the checkpoint being written.
+     */
+    ~CheckpointWriter();
+
+    /**
+     * @brief Sets the checkpoint file and the number of iterations between checkpoints.
+     *
+     * @param fileName The name of the checkpoint file, empty to disable checkpoints.
+     * @param interval The number of iterations between two checkpoints.
+     */
+    void setFile(const QString& fileName, int interval);
+
+    /**
+     * @brief Checks if checkpoints are enabled.
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Checks if a checkpoint is due after the given iteration.
+     */
+    bool isDue(int iteration) const;
+
+    /**
+     * @brief Forgets the history of the previous computation.
+     *
+     * Must be called when the history passed to submit() was cleared or replaced, so the next
+     * checkpoint copies it in full.
+     */
+    void restart();
+
+    /**
+     * @brief Starts writing a checkpoint in the background, unless a write is still running.
+     *
+     * @param state The state to write, its x and history are ignored in favour of the parameters.
+     * @param x Pointer to the current approximation of the solution.
+     * @param size The number of unknowns.
+     * @param history The convergence history, only grown by appending since restart().
+     * @return true if the checkpoint was started, false if it was skipped.
+     */
+    bool submit(const Checkpoint& state, const double* x, int size, const QVector<double>& history);
+
+    /**
+     * @brief Waits for the checkpoint being written, if any.
+     */
+    void waitForFinished();
+
+private:
+    QThreadPool pool;  ///< The single thread that writes the checkpoints.
+    QString fileName;  ///< The name of the checkpoint file.
+    int interval;  ///< The number of iterations between two checkpoints.
+    Checkpoint snapshot;  ///< The state being written, its history is kept between checkpoints.
+    QFuture<void> pending;  ///< The background write of snapshot.
+};
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,23 @@
+#ifndef JACOBIGLOBAL_H
+#define JACOBIGLOBAL_H
+
+#include <QtGlobal>
+
+/**
+ * @def JACOBI_EXPORT
+ * @brief Marks the classes exported by the solver library.
+ *
+ * The library is static by default. When it is built as a shared library (qmake CONFIG+=jacobi_shared),
+ * JACOBI_SHARED is defined for the library and its users and JACOBI_LIBRARY only for the library itself.
+ */
+#if defined(JACOBI_SHARED)
+#  if defined(JACOBI_LIBRARY)
+#    define JACOBI_EXPORT Q_DECL_EXPORT
+#  else
+#    define JACOBI_EXPORT Q_DECL_IMPORT
+#  endif
+#else
+#  define JACOBI_EXPORT
+#endif
+
+#endif // JACOBIGLOBAL_H
@@ -0,0 +1,126 @@
+#ifndef JACOBIMATRIX_H
+#define JACOBIMATRIX_H
+
+#include <QVector>
+
+/**
+ * @class JacobiMatrix
+ * @brief Row-major coefficient storage for the Jacobi sweep with a configurable scalar type.
+ *
+ * The matrix is stored as Scalar (double, float or BFloat16) while all products are accumulated
+ * in double, so a narrower Scalar reduces the number of bytes streamed per sweep without losing
+ * precision in the sums. A JacobiMatrix<double> can also be a view of existing row-major data.
+ * Optional row extents limit every row to the columns between its first and last nonzero entry,
+ * so banded or reordered matrices only stream their envelope.
+ *
+ * @tparam Scalar The type used to store the coefficients.
+ */
+template <typename Scalar>
+class JacobiMatrix
+{
+public:
+    JacobiMatrix() = default;
+
+    /**
+     * @brief Creates a matrix holding a copy of row-major double data converted to Scalar.
+     *
+     * @param data Pointer to the first coefficient, rows stored one after another.
+     * @param size The number of rows and columns.
+     * @param stride The distance between the starts of two consecutive rows in data.
+     * @return The converted matrix, stored without gaps between rows.
+     */
+    static JacobiMatrix convert(const double* data, int size, qsizetype stride)
+    {
+        JacobiMatrix m;
+        m.n = size;
+        m.stride = size;
+        m.storage.resize(qsizetype(size) * size);
+        for (int i = 0; i < size; ++i) {
+            const double* src = data + qsizetype(i) * stride;
+            Scalar* dst = m.storage.data() + qsizetype(i) * size;
+            for (int j = 0; j < size; ++j) {
+                dst[j] = static_cast<Scalar>(src[j]);
+            }
+        }
+        return m;
+    }
+
+    /**
+     * @brief Creates a matrix that reads existing row-major data without copying it.
+     *
+     * The data must outlive the returned matrix.
+     *
+     * @param data Pointer to the first coefficient, rows stored one after another.
+     * @param size The number of rows and columns.
+     * @param stride The distance between the starts of two consecutive rows in data.
+     * @return The matrix view.
+     */
+    static JacobiMatrix view(const Scalar* data, int size, qsizetype stride)
+    {
+        JacobiMatrix m;
+        m.n = size;
+        m.stride = stride;
+        m.external = data;
+        return m;
+    }
+
+    /**
+     * @brief Limits every row to the columns between its first and last nonzero entry.
+     *
+     * @param first The column of the first nonzero entry of every row.
+     * @param last The column of the last nonzero entry of every row.
+     */
+    void setRowExtents(const QVector<int>& first, const QVector<int>& last)
+    {
+        rowFirst = first;
+        rowLast = last;
+    }
+
+    /**
+     * @brief Gets the number of rows and columns.
+     */
+    int size() const { return n; }
+
+    /**
+     * @brief Gets a pointer to the first coefficient of a row.
+     */
+    const Scalar* row(int i) const
+    {
+        return (external ? external : storage.constData()) + qsizetype(i) * stride;
+    }
+
+    /**
+     * @brief Computes the sum of a[i][j] * x[j] over all j != i in double precision.
+     *
+     * The diagonal is skipped by splitting the row into two branch-free loops, and columns outside
+     * the row extents, if set, are not visited at all.
+     *
+     * @param i The row index.
+     * @param x Pointer to the current approximation of the solution.
+     * @return The off-diagonal product of the row.
+     */
+    double offDiagonalProduct(int i, const double* x) const
+    {
+        const Scalar* a = row(i);
+        const int lo = rowFirst.isEmpty() ? 0 : rowFirst[i];
+        const int hi = rowLast.isEmpty() ? n : rowLast[i] + 1;
+        double sum = 0.0;
+        for (int j = lo; j < i; ++j) {
+            sum += static_cast<double>(a[j]) * x[j];
+        }
+        for (int j = i + 1; j < hi; ++j) {
+            sum += static_cast<double>(a[j]) * x[j];
+        }
+        return sum;
+    }
+
+private:
+    QVector<Scalar> storage;  ///< Owned coefficients, empty for views.
+    const Scalar* external = nullptr;  ///< Viewed coefficients, nullptr when the storage is owned.
+    int n = 0;  ///< The number of rows and columns.
+    qsizetype stride = 0;  ///< The distance between the starts of two consecutive rows.
+    QVector<int> rowFirst;  ///< The first nonzero column of every row, empty to visit all columns.
+    QVector<int> rowLast;  ///< The last nonzero column of every row, empty to visit all columns.
+};
+
+#endif // JACOBIMATRIX_H
@@ -1,9 +1,23 @@
 #include "JacobiSolver.h"
+#include "BFloat16.h"
+#include "Checkpoint.h"
 #include <QDebug>
+#include <QLoggingCategory>
+#include <QRandomGenerator>
+#include <algorithm>
 #include <cmath>
-#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <type_traits>
 #include <QtConcurrent>
 
+namespace {
+
+// Per-iteration messages are debug output of this category, off unless enabled through the logging rules
+Q_LOGGING_CATEGORY(lcSolver, "jacobi.solver", QtInfoMsg)
+
+} // namespace
+
 /**
  * @class JacobiSolver
  * @brief A class to solve a system of linear equations using the Jacobi method.
@@ -23,16 +37,15 @@
  * @param parent The parent QObject (default is nullptr).
  */
 JacobiSolver::JacobiSolver(int size, QObject* parent)
-    : QObject(parent), size(size) {
-    matrix.resize(size, QVector<double>(size, 0));
-    b.resize(size, 0);
+    : QObject(parent), size(size), precision(Precision::Double), refinement(false),
+      cancelRequested(false), promise(nullptr), iteration(0), bestResidual(0.0),
+      systemHash(0), resumeIteration(0), resumeRefining(false), refining(false) {
     x.resize(size, 0);
     xNew.resize(size, 0);
-    xOld.resize(size, 0);
 
-    srand(time(0));
+    // QRandomGenerator::global() is thread-safe, several solvers may be set up at the same time
     for (int i = 0; i < size; ++i) {
-        x[i] = rand() % 10 + 1;
+        x[i] = QRandomGenerator::global()->bounded(1, 11);
     }
 }
 
@@ -45,103 +58,520 @@ JacobiSolver::JacobiSolver(int size, QObject* parent)
 JacobiSolver::~JacobiSolver() {}
 
 /**
- * @brief Normalizes the matrix and right-hand side vector.
+ * @brief Computes the reciprocals of the diagonal elements of the matrix.
  *
- * This function normalizes the matrix such that the diagonal elements are 1.0
- * and scales the right-hand side vector accordingly. It also sets the diagonal elements to 0.
+ * Instead of normalizing the matrix in place, every sweep divides its row sums by the diagonal
+ * element, so the same coefficients can be used in any storage precision.
  *
- * @param matrix The system coefficient matrix to be normalized.
- * @param b The right-hand side vector.
+ * @return true if the system can be solved, false if the matrix or b is missing, does not match
+ *         the system size or has a zero on the diagonal.
  */
-void JacobiSolver::normalizeMatrix(QVector<QVector<double>>& matrix, QVector<double>& b) {
-    for (int r = 0; r < matrix.size(); ++r) {
-        double diag = matrix[r][r];
+bool JacobiSolver::computeInverseDiagonal() {
+    if (!matrix.data || !b.data) {
+        qCWarning(lcSolver) << "Error: Matrix or vector b was not set.";
+        return false;
+    }
+    if (matrix.rows != size || matrix.cols != size || b.size != size) {
+        qCWarning(lcSolver) << "Error: Matrix or vector b does not match the system size" << size;
+        return false;
+    }
+
+    invDiag.resize(size);
+    for (int r = 0; r < size; ++r) {
+        double diag = matrix.row(r)[r];
         if (qFuzzyIsNull(diag)) {
-            qFatal("Error: Zero diagonal element at row %d!", r);
+            qCWarning(lcSolver) << "Error: Zero diagonal element at row" << r + 1;
+            return false;
         }
-        for (int s = 0; s < matrix[r].size(); ++s) {
-            if (r != s) {
-                matrix[r][s] /= diag;
+        invDiag[r] = 1.0 / diag;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks the iteration limit, the time budget and cancellation requests.
+ *
+ * @param status Set to the reason for stopping, if any.
+ * @return true if the computation should stop, false otherwise.
+ */
+bool JacobiSolver::limitReached(Status& status) {
+    if (cancelRequested.load(std::memory_order_relaxed) || (promise && promise->isCanceled())) {
+        status = Status::Cancelled;
+        return true;
+    }
+    if (options.maxIterations > 0 && iteration >= options.maxIterations) {
+        status = Status::IterationLimit;
+        return true;
+    }
+    if (options.timeBudget > 0.0 && timer.elapsed() >= qint64(options.timeBudget * 1000.0)) {
+        status = Status::TimeBudget;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Computes the first and the last nonzero column of every row of the matrix.
+ *
+ * The rows are scanned in parallel. The sweeps skip the columns outside these extents,
+ * which pays off for banded matrices and for matrices reordered by MatrixReorderer.
+ */
+void JacobiSolver::computeRowExtents() {
+    rowFirst.resize(size);
+    rowLast.resize(size);
+    int* first = rowFirst.data();  // Detach once here, the threads only write through the pointers
+    int* last = rowLast.data();
+    const MatrixView m = matrix;
+
+    QVector<int> rows(size);
+    std::iota(rows.begin(), rows.end(), 0);
+    QtConcurrent::blockingMap(rows, [m, first, last](int i) {
+        const double* row = m.row(i);
+        int lo = i;
+        int hi = i;
+        for (int j = 0; j < m.cols; ++j) {
+            if (row[j] != 0.0) {
+                lo = std::min(lo, j);
+                hi = std::max(hi, j);
             }
         }
-        b[r] /= diag;
-        matrix[r][r] = 0.0;
+        first[i] = lo;
+        last[i] = hi;
+    });
+}
+
+/**
+ * @brief Prepares the coefficients for the sweeps in the requested storage type.
+ *
+ * Double coefficients are a view of the matrix, other types are converted copies.
+ * Both are limited to the row extents.
+ *
+ * @return The coefficients used by the sweeps.
+ */
+template <typename Scalar>
+JacobiMatrix<Scalar> JacobiSolver::prepareMatrix() const {
+    JacobiMatrix<Scalar> a;
+    if constexpr (std::is_same_v<Scalar, double>) {
+        a = JacobiMatrix<double>::view(matrix.data, size, matrix.stride);
+    } else {
+        a = JacobiMatrix<Scalar>::convert(matrix.data, size, matrix.stride);
     }
+    a.setRowExtents(rowFirst, rowLast);
+    return a;
 }
 
 /**
- * @brief Solves the system of equations using the Jacobi method.
+ * @brief Performs one Jacobi sweep from x into xNew.
  *
- * The solve function performs the iterative Jacobi method until the solution converges.
- * It computes the solution vector by updating it iteratively and checking for convergence.
+ * Splits the rows between the available threads and computes
+ *     xNew[i] = (b[i] - sum(a[i][j] * x[j])) / a[i][i] for all j != i
+ * with the products accumulated in double precision.
  *
- * @param epsilon The tolerance for convergence. The iteration stops when the maximum change
- *                in the solution vector is less than this value.
+ * @param a The coefficients used by the sweep.
  */
-void JacobiSolver::solve(double epsilon) {
-    bool converged = false;
-    int iteration = 0;
-    normalizeMatrix(matrix, b);
+template <typename Scalar>
+void JacobiSolver::sweep(const JacobiMatrix<Scalar>& a) {
+    const double* rhs = b.data;
+    const double* inv = invDiag.constData();
+    const double* xOld = x.constData();
+    double* out = xNew.data();  // Detach once here, the threads only write through the pointer
+
+    QFutureSynchronizer<void> synchronizer;  // Synchronizer to manage multiple threads
+    int numThreads = QThread::idealThreadCount();
+    int rowsPerThread = size / numThreads;
+
+    // Create threads and assign them to compute different parts of the matrix
+    for (int t = 0; t < numThreads; ++t) {
+        int startRow = t * rowsPerThread;  // Calculate the start row for this thread
+        int endRow = (t == numThreads - 1) ? size : startRow + rowsPerThread;
+
+        synchronizer.addFuture(QtConcurrent::run([&a, rhs, inv, xOld, out, startRow, endRow]() {
+            // Perform computation for rows assigned to this thread
+            for (int i = startRow; i < endRow; ++i) {
+                out[i] = (rhs[i] - a.offDiagonalProduct(i, xOld)) * inv[i];
+            }
+        }));
+    }
 
-    while (!converged) {
+    synchronizer.waitForFinished();
+}
+
+/**
+ * @brief Runs Jacobi iterations with the given coefficients until a stopping criterion is met.
+ *
+ * The limits are checked between sweeps, and the iterate with the smallest maximum change
+ * is remembered in bestX.
+ *
+ * @param a The coefficients used by the sweeps.
+ * @return The reason the iteration stopped.
+ */
+template <typename Scalar>
+JacobiSolver::Status JacobiSolver::iterate(const JacobiMatrix<Scalar>& a) {
+    Status status = Status::Converged;
+
+    while (!limitReached(status)) {
         iteration++;
-        qDebug() << "Iteration:" << iteration;
-
-        xOld = x;
-
-        QFutureSynchronizer<void> synchronizer;  // Synchronizer to manage multiple threads
-        int numThreads = QThread::idealThreadCount();
-        int rowsPerThread = size / numThreads;
-
-        // Create threads and assign them to compute different parts of the matrix
-        for (int t = 0; t < numThreads; ++t) {
-            int startRow = t * rowsPerThread;  // Calculate the start row for this thread
-            int endRow = (t == numThreads - 1) ? size : startRow + rowsPerThread;
-
-            synchronizer.addFuture(QtConcurrent::run([this, startRow, endRow]() {
-                // Perform computation for rows assigned to this thread
-                for (int i = startRow; i < endRow; ++i) {
-                    double sum = 0.0;
-                    // Perform the Jacobi iteration: xNew[i] = b[i] - sum
-                    for (int j = 0; j < matrix.size(); ++j) {
-                        if (i != j) {
-                            sum += matrix[i][j] * xOld[j];
-                        }
-                    }
-                    xNew[i] = b[i] - sum;
-                }
-            }));
-        }
+        qCDebug(lcSolver) << "Iteration:" << iteration;
 
-        synchronizer.waitForFinished();
+        sweep(a);
 
         double maxChange = 0.0;
         for (int i = 0; i < size; ++i) {
             maxChange = std::max(maxChange, std::abs(xNew[i] - x[i]));
         }
 
-        qDebug() << "Max change:" << maxChange;
+        qCDebug(lcSolver) << "Max change:" << maxChange;
+
+        emit progress(iteration, maxChange);
+        if (promise) {
+            promise->setProgressValueAndText(iteration, QString::number(maxChange));
+        }
+
+        history.append(maxChange);
 
-        if (maxChange < epsilon) {
-            qDebug() << "Converged!";
-            converged = true;
-        } else {
-            std::swap(x, xNew);
+        if (maxChange < bestResidual) {
+            bestResidual = maxChange;
+            bestX = xNew;
         }
+
+        if (maxChange < options.epsilon) {
+            qCDebug(lcSolver) << "Converged!";
+            return Status::Converged;
+        }
+        std::swap(x, xNew);
+
+        if (checkpoints.isDue(iteration)) {
+            writeCheckpoint(maxChange);
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Solves the system of equations using the Jacobi method.
+ *
+ * The solve function performs the iterative Jacobi method until the solution converges.
+ *
+ * @param epsilon The tolerance for convergence. The iteration stops when the maximum change
+ *                in the solution vector is less than this value.
+ */
+void JacobiSolver::solve(double epsilon) {
+    Options unlimited;
+    unlimited.epsilon = epsilon;
+    solve(unlimited);
+}
+
+/**
+ * @brief Solves the system of equations with the given stopping criteria.
+ *
+ * With reduced precision storage the coefficients are converted once before the first sweep,
+ * and the optional refinement phase continues from the converged iterate with the double
+ * coefficients. The iteration and time limits cover both phases. If the computation stops
+ * before converging, the solution is replaced by the best iterate seen so far.
+ * After resume() the iteration continues from the restored state, and the iteration limit
+ * counts the restored iterations too. A state saved during the refinement phase continues
+ * with the refinement phase directly.
+ *
+ * @param options The convergence threshold and the iteration and time limits.
+ * @return The outcome of the computation.
+ */
+JacobiSolver::Report JacobiSolver::solve(const Options& options) {
+    this->options = options;
+    iteration = resumeIteration;
+    resumeIteration = 0;
+    if (iteration == 0) {
+        history.clear();
+    }
+    bestResidual = std::numeric_limits<double>::infinity();
+    bestX = x;
+    timer.start();
+
+    if (promise && options.maxIterations > 0) {
+        promise->setProgressRange(0, options.maxIterations);
+    }
+
+    if (!computeInverseDiagonal()) {
+        Report report;
+        report.status = Status::InvalidInput;
+        report.iterations = iteration;
+        latestReport = report;
+        cancelRequested.store(false, std::memory_order_relaxed);
+        emit finished();
+        return report;
+    }
+
+    if (checkpoints.isEnabled()) {
+        systemHash = Checkpoint::hashSystem(matrix, b);
+        checkpoints.restart();  // The history was cleared or restored above
+    }
+
+    computeRowExtents();
+
+    Status status = Status::Converged;
+    const bool refine = refinement && precision != Precision::Double;
+    refining = refine && resumeRefining;
+    resumeRefining = false;
+
+    switch (refining ? Precision::Double : precision) {
+    case Precision::Double:
+        status = iterate(prepareMatrix<double>());
+        break;
+    case Precision::Float:
+        status = iterate(prepareMatrix<float>());
+        break;
+    case Precision::BFloat16:
+        status = iterate(prepareMatrix<BFloat16>());
+        break;
+    }
+
+    if (status == Status::Converged && refine && !refining) {
+        qCDebug(lcSolver) << "Refining in double precision";
+        refining = true;
+        int firstPhase = iteration;
+        status = iterate(prepareMatrix<double>());
+        qCDebug(lcSolver) << "Refinement iterations:" << iteration - firstPhase;
+    }
+
+    Report report;
+    report.status = status;
+    report.iterations = iteration;
+    report.seconds = timer.elapsed() / 1000.0;
+
+    if (status == Status::Converged) {
+        report.residual = bestResidual;
+    } else {
+        qCDebug(lcSolver) << "Stopped before convergence, keeping the best iterate";
+        x = bestX;
+        report.residual = bestResidual;
+    }
+
+    if (checkpoints.isEnabled()) {
+        // The final state is written synchronously, so a preempted run can always be resumed
+        checkpoints.waitForFinished();
+        writeCheckpoint(report.residual);
+        checkpoints.waitForFinished();
+    }
+
+    latestReport = report;
+    cancelRequested.store(false, std::memory_order_relaxed);  // The request applied to this computation
+    emit finished();  // Emit finished signal when the computation has stopped
+    return report;
+}
+
+/**
+ * @brief Starts solving the system of equations in the global thread pool.
+ *
+ * If the future is cancelled, the promise drops the result, the Report is kept in lastReport().
+ *
+ * @param options The convergence threshold and the iteration and time limits.
+ * @return A future that receives the outcome of the computation.
+ */
+QFuture<JacobiSolver::Report> JacobiSolver::solveAsync(const Options& options) {
+    return QtConcurrent::run([this, options](QPromise<Report>& p) {
+        promise = &p;
+        Report report = solve(options);
+        promise = nullptr;
+        p.addResult(report);
+    });
+}
+
+/**
+ * @brief Gets the outcome of the last finished computation.
+ *
+ * @return The Report of the last solve.
+ */
+JacobiSolver::Report JacobiSolver::lastReport() const {
+    return latestReport;
+}
+
+/**
+ * @brief Requests the running computation to stop.
+ *
+ * Only sets an atomic flag, the computing thread notices it after the current sweep.
+ * A request made before a computation starts stops that computation right away.
+ */
+void JacobiSolver::cancel() {
+    cancelRequested.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Measures the average wall-clock time of one sweep.
+ *
+ * @param a The coefficients used by the sweeps.
+ * @param repeats The number of sweeps to time.
+ * @return The average time of one sweep in seconds.
+ */
+template <typename Scalar>
+double JacobiSolver::timeSweeps(const JacobiMatrix<Scalar>& a, int repeats) {
+    QElapsedTimer sweepTimer;
+    sweepTimer.start();
+    for (int r = 0; r < repeats; ++r) {
+        sweep(a);
+    }
+    return sweepTimer.nsecsElapsed() / 1e9 / repeats;
+}
+
+/**
+ * @brief Measures the average wall-clock time of one sweep with the current settings.
+ *
+ * The sweeps only write the next iterate, the current approximation of the solution is kept.
+ *
+ * @param repeats The number of sweeps to time.
+ * @return The average time of one sweep in seconds, -1 if the system cannot be solved.
+ */
+double JacobiSolver::measureSweepTime(int repeats) {
+    if (!computeInverseDiagonal()) {
+        return -1.0;
     }
+    computeRowExtents();
+    repeats = std::max(1, repeats);
 
-    emit finished();  // Emit finished signal when the solution has converged
+    switch (precision) {
+    case Precision::Float:
+        return timeSweeps(prepareMatrix<float>(), repeats);
+    case Precision::BFloat16:
+        return timeSweeps(prepareMatrix<BFloat16>(), repeats);
+    case Precision::Double:
+        break;
+    }
+    return timeSweeps(prepareMatrix<double>(), repeats);
+}
+
+/**
+ * @brief Hands the current state to the background checkpoint writer.
+ *
+ * The writer copies x and the history entries added since its last checkpoint into its snapshot,
+ * so the next sweep can start right away. If the previous checkpoint is still being written,
+ * this one is skipped.
+ *
+ * @param residual The maximum change of the last iteration.
+ */
+void JacobiSolver::writeCheckpoint(double residual) {
+    Checkpoint state;
+    state.systemHash = systemHash;
+    state.iteration = iteration;
+    state.residual = residual;
+    state.refining = refining;
+    checkpoints.submit(state, x.constData(), size, history);
+}
+
+/**
+ * @brief Enables periodic checkpoints of the solver state.
+ *
+ * @param fileName The name of the checkpoint file, empty to disable checkpoints.
+ * @param interval The number of iterations between two checkpoints.
+ */
+void JacobiSolver::setCheckpoint(const QString& fileName, int interval) {
+    checkpoints.setFile(fileName, interval);
+}
+
+/**
+ * @brief Restores the state saved in a checkpoint.
+ *
+ * The checkpoint is accepted only if it was written for a system of the same size with the
+ * same matrix and right-hand side, which is verified through their hash.
+ *
+ * @param fileName The name of the checkpoint file.
+ * @return true if the state was restored, false otherwise.
+ */
+bool JacobiSolver::resume(const QString& fileName) {
+    if (!matrix.data || !b.data) {
+        qCWarning(lcSolver) << "Error: The matrix and vector b must be set before resuming.";
+        return false;
+    }
+
+    Checkpoint checkpoint;
+    if (!Checkpoint::load(fileName, checkpoint)) {
+        return false;
+    }
+
+    if (checkpoint.x.size() != size) {
+        qCWarning(lcSolver) << "Error: The checkpoint belongs to a system of a different size.";
+        return false;
+    }
+
+    if (checkpoint.systemHash != Checkpoint::hashSystem(matrix, b)) {
+        qCWarning(lcSolver) << "Error: The checkpoint does not match the matrix and vector b.";
+        return false;
+    }
+
+    x = checkpoint.x;
+    history = checkpoint.history;
+    resumeIteration = checkpoint.iteration;
+    resumeRefining = checkpoint.refining;
+
+    qCInfo(lcSolver) << "Resuming from iteration" << resumeIteration << "with max change" << checkpoint.residual;
+    return true;
+}
+
+/**
+ * @brief Gets the maximum change of every iteration of the last computation.
+ *
+ * @return The convergence history, including iterations restored by resume().
+ */
+QVector<double> JacobiSolver::getHistory() const {
+    return history;
 }
 
 /**
  * @brief Sets the coefficient matrix.
  *
  * This function sets the matrix of the system of linear equations.
+ * The rows are copied into one contiguous row-major buffer.
  *
  * @param m The coefficient matrix.
+ * @return true if the matrix is size x size, false otherwise (the matrix is then left unset).
+ */
+bool JacobiSolver::setMatrix(const QVector<QVector<double>>& m) {
+    bool square = m.size() == size;
+    for (int r = 0; square && r < size; ++r) {
+        square = m[r].size() == size;
+    }
+    if (!square) {
+        qCWarning(lcSolver) << "Error: The matrix does not match the system size" << size;
+        setMatrix(MatrixView{});
+        return false;
+    }
+
+    QVector<double> flat(qsizetype(size) * size);
+    for (int r = 0; r < size; ++r) {
+        std::copy(m[r].constBegin(), m[r].constEnd(), flat.begin() + qsizetype(r) * size);
+    }
+    return setMatrix(std::move(flat));
+}
+
+/**
+ * @brief Moves a row-major matrix into the solver.
+ *
+ * @param m The size * size coefficients of the system, stored row by row.
+ * @return true if m holds size * size coefficients, false otherwise (the matrix is then left unset).
+ */
+bool JacobiSolver::setMatrix(QVector<double>&& m) {
+    if (m.size() != qsizetype(size) * size) {
+        qCWarning(lcSolver) << "Error: The matrix does not match the system size" << size;
+        return setMatrix(MatrixView{});
+    }
+    ownedMatrix = std::move(m);
+    matrix = MatrixView{ownedMatrix.constData(), size, size, size};
+    return true;
+}
+
+/**
+ * @brief Uses a matrix owned by the caller without copying it.
+ *
+ * @param m A size x size view of the coefficients of the system.
+ * @return true if the view is size x size, false otherwise (the matrix is then left unset).
  */
-void JacobiSolver::setMatrix(const QVector<QVector<double>>& m) {
+bool JacobiSolver::setMatrix(const MatrixView& m) {
+    ownedMatrix = QVector<double>();
+    if (m.data && (m.rows != size || m.cols != size || m.stride < size)) {
+        qCWarning(lcSolver) << "Error: The matrix does not match the system size" << size;
+        matrix = MatrixView{};
+        return false;
+    }
     matrix = m;
+    return m.data != nullptr;
 }
 
 /**
@@ -150,9 +580,43 @@ void JacobiSolver::setMatrix(const QVector<QVector<double>>& m) {
  * This function sets the right-hand side vector (b) for the system of linear equations.
  *
  * @param rhs The right-hand side vector.
+ * @return true if rhs holds size values, false otherwise (the vector is then left unset).
+ */
+bool JacobiSolver::setB(const QVector<double>& rhs) {
+    return setB(QVector<double>(rhs));
+}
+
+/**
+ * @brief Moves the right-hand side vector into the solver.
+ *
+ * @param rhs The right-hand side vector.
+ * @return true if rhs holds size values, false otherwise (the vector is then left unset).
+ */
+bool JacobiSolver::setB(QVector<double>&& rhs) {
+    if (rhs.size() != size) {
+        qCWarning(lcSolver) << "Error: Vector b does not match the system size" << size;
+        return setB(VectorView{});
+    }
+    ownedB = std::move(rhs);
+    b = VectorView{ownedB.constData(), size};
+    return true;
+}
+
+/**
+ * @brief Uses a right-hand side vector owned by the caller without copying it.
+ *
+ * @param rhs A view of the right-hand side vector.
+ * @return true if the view holds size values, false otherwise (the vector is then left unset).
  */
-void JacobiSolver::setB(const QVector<double>& rhs) {
+bool JacobiSolver::setB(const VectorView& rhs) {
+    ownedB = QVector<double>();
+    if (rhs.data && rhs.size != size) {
+        qCWarning(lcSolver) << "Error: Vector b does not match the system size" << size;
+        b = VectorView{};
+        return false;
+    }
     b = rhs;
+    return rhs.data != nullptr;
 }
 
 /**
@@ -165,3 +629,30 @@ void JacobiSolver::setB(const QVector<double>& rhs) {
 QVector<double> JacobiSolver::getResult() {
     return x;
 }
+
+/**
+ * @brief Writes the computed solution vector into a buffer provided by the caller.
+ *
+ * @param out Pointer to at least size doubles that receive the solution.
+ */
+void JacobiSolver::getResult(double* out) const {
+    std::copy(x.constBegin(), x.constEnd(), out);
+}
+
+/**
+ * @brief Sets the precision of the coefficients used by the sweeps.
+ *
+ * @param p The storage precision.
+ */
+void JacobiSolver::setPrecision(Precision p) {
+    precision = p;
+}
+
+/**
+ * @brief Enables a final refinement phase in double precision.
+ *
+ * @param enabled true to enable the refinement phase.
+ */
+void JacobiSolver::setRefinement(bool enabled) {
+    refinement = enabled;
+}
@@ -5,6 +5,13 @@
 #include <QVector>
 #include <QtConcurrent>
 #include <QFuture>
+#include <QPromise>
+#include <QElapsedTimer>
+#include <atomic>
+#include "Checkpoint.h"
+#include "JacobiGlobal.h"
+#include "JacobiMatrix.h"
+#include "MatrixView.h"
 
 /**
  * @class JacobiSolver
@@ -12,11 +19,67 @@
  *
  * This class solves a system of linear equations using the Jacobi iterative method.
  * It supports parallel execution of the method across multiple threads to speed up the computation.
+ * The coefficients used by the sweeps can be stored in reduced precision while all sums and
+ * iterates stay in double, optionally followed by a refinement phase in full precision.
+ * The computation can run asynchronously with progress reporting, cooperative cancellation,
+ * an iteration limit and a wall-clock budget.
+ *
+ * The matrix and the right-hand side can be moved into the solver or passed as views of memory
+ * owned by the caller, in which case the solver reads them in place without copying.
+ * Long computations can write periodic checkpoints in the background and be resumed from them.
+ *
+ * Invalid input is reported through Status::InvalidInput instead of stopping the process, and the
+ * per-iteration messages are debug output of the "jacobi.solver" logging category, which is off
+ * by default (enable it with the rule "jacobi.solver.debug=true").
  */
-class JacobiSolver : public QObject {
+class JACOBI_EXPORT JacobiSolver : public QObject {
     Q_OBJECT
 
 public:
+    /**
+     * @brief The scalar type used to store the coefficients during the sweeps.
+     */
+    enum class Precision {
+        Double,    ///< 8 bytes per coefficient.
+        Float,     ///< 4 bytes per coefficient.
+        BFloat16   ///< 2 bytes per coefficient.
+    };
+
+    /**
+     * @brief The reason the iteration stopped.
+     */
+    enum class Status {
+        Converged,       ///< The maximum change dropped below epsilon.
+        IterationLimit,  ///< The iteration limit was reached.
+        TimeBudget,      ///< The wall-clock budget ran out.
+        Cancelled,       ///< The computation was cancelled.
+        InvalidInput     ///< The matrix or b is missing, has the wrong size or a zero on the diagonal.
+    };
+
+    /**
+     * @struct Options
+     * @brief Stopping criteria of one solve.
+     */
+    struct Options {
+        double epsilon = 0.0;  ///< The convergence threshold (stopping criterion).
+        int maxIterations = 0;  ///< The maximum number of iterations, 0 for no limit.
+        double timeBudget = 0.0;  ///< The wall-clock budget in seconds, 0 for no limit.
+    };
+
+    /**
+     * @struct Report
+     * @brief The outcome of one solve.
+     *
+     * Unless the status is Status::Converged, the result holds the iterate with the smallest
+     * maximum change seen before the computation stopped.
+     */
+    struct Report {
+        Status status = Status::Converged;  ///< The reason the iteration stopped.
+        int iterations = 0;  ///< The total number of iterations performed.
+        double residual = 0.0;  ///< The maximum change of the returned iterate.
+        double seconds = 0.0;  ///< The wall-clock time spent iterating.
+    };
+
     /**
      * @brief Constructs a JacobiSolver object.
      *
@@ -41,8 +104,27 @@ public:
      * This function takes a matrix as input and sets it as the system's matrix.
      *
      * @param m The matrix representing the coefficients of the system.
+     * @return true if the matrix is size x size, false otherwise (the matrix is then left unset).
      */
-    void setMatrix(const QVector<QVector<double>>& m);
+    bool setMatrix(const QVector<QVector<double>>& m);
+
+    /**
+     * @brief Moves a row-major matrix into the solver.
+     *
+     * @param m The size * size coefficients of the system, stored row by row.
+     * @return true if m holds size * size coefficients, false otherwise (the matrix is then left unset).
+     */
+    bool setMatrix(QVector<double>&& m);
+
+    /**
+     * @brief Uses a matrix owned by the caller without copying it.
+     *
+     * The memory must stay valid and unchanged until the solver is destroyed or another matrix is set.
+     *
+     * @param m A size x size view of the coefficients of the system.
+     * @return true if the view is size x size, false otherwise (the matrix is then left unset).
+     */
+    bool setMatrix(const MatrixView& m);
 
     /**
      * @brief Sets the right-hand side vector (b).
@@ -50,8 +132,27 @@ public:
      * This function sets the right-hand side vector for the system of equations.
      *
      * @param rhs The right-hand side vector representing the constants.
+     * @return true if rhs holds size values, false otherwise (the vector is then left unset).
      */
-    void setB(const QVector<double>& rhs);
+    bool setB(const QVector<double>& rhs);
+
+    /**
+     * @brief Moves the right-hand side vector (b) into the solver.
+     *
+     * @param rhs The right-hand side vector representing the constants.
+     * @return true if rhs holds size values, false otherwise (the vector is then left unset).
+     */
+    bool setB(QVector<double>&& rhs);
+
+    /**
+     * @brief Uses a right-hand side vector owned by the caller without copying it.
+     *
+     * The memory must stay valid and unchanged until the solver is destroyed or another vector is set.
+     *
+     * @param rhs A view of the size constants of the system.
+     * @return true if the view holds size values, false otherwise (the vector is then left unset).
+     */
+    bool setB(const VectorView& rhs);
 
     /**
      * @brief Gets the result vector after solving the system.
@@ -62,6 +163,75 @@ public:
      */
     QVector<double> getResult();
 
+    /**
+     * @brief Writes the result vector into a buffer provided by the caller.
+     *
+     * @param out Pointer to at least size doubles that receive the solution.
+     */
+    void getResult(double* out) const;
+
+    /**
+     * @brief Sets the precision of the coefficients used by the sweeps.
+     *
+     * Accumulators and iterates always stay in double.
+     *
+     * @param p The storage precision (default is Precision::Double).
+     */
+    void setPrecision(Precision p);
+
+    /**
+     * @brief Enables a final refinement phase in double precision.
+     *
+     * After the iteration with reduced precision coefficients converges, the iteration continues
+     * with the double coefficients until it converges again, which recovers full precision
+     * residuals. Has no effect with Precision::Double.
+     *
+     * @param enabled true to enable the refinement phase.
+     */
+    void setRefinement(bool enabled);
+
+    /**
+     * @brief Enables periodic checkpoints of the solver state.
+     *
+     * Every interval iterations the current iterate, the iteration count and the convergence
+     * history are written to the file by a background thread; a checkpoint is skipped rather than
+     * delaying the sweeps if the previous one is still being written. The final state is always
+     * written when the computation stops.
+     *
+     * @param fileName The name of the checkpoint file, empty to disable checkpoints.
+     * @param interval The number of iterations between two checkpoints.
+     */
+    void setCheckpoint(const QString& fileName, int interval);
+
+    /**
+     * @brief Restores the state saved in a checkpoint.
+     *
+     * Must be called after the matrix and the right-hand side are set, the checkpoint is accepted
+     * only if it was written for the same system. The next solve continues from the restored state.
+     *
+     * @param fileName The name of the checkpoint file.
+     * @return true if the state was restored, false otherwise.
+     */
+    bool resume(const QString& fileName);
+
+    /**
+     * @brief Gets the maximum change of every iteration of the last computation.
+     *
+     * @return The convergence history, including iterations restored by resume().
+     */
+    QVector<double> getHistory() const;
+
+    /**
+     * @brief Measures the average wall-clock time of one sweep with the current settings.
+     *
+     * Does not change the current approximation of the solution. Useful to compare the cost
+     * of a sweep before and after reordering the matrix.
+     *
+     * @param repeats The number of sweeps to time.
+     * @return The average time of one sweep in seconds, -1 if the system cannot be solved.
+     */
+    double measureSweepTime(int repeats);
+
     /**
      * @brief Solves the system of equations using the Jacobi method.
      *
@@ -72,6 +242,49 @@ public:
      */
     void solve(double epsilon);
 
+    /**
+     * @brief Solves the system of equations with the given stopping criteria.
+     *
+     * Runs in the calling thread. A system that cannot be solved, because the matrix or b is
+     * missing or the diagonal has a zero, returns Status::InvalidInput without iterating.
+     *
+     * @param options The convergence threshold and the iteration and time limits.
+     * @return The outcome of the computation.
+     */
+    Report solve(const Options& options);
+
+    /**
+     * @brief Starts solving the system of equations in the global thread pool.
+     *
+     * The returned future reports the iteration number as its progress value and the maximum
+     * change of that iteration as its progress text. Use cancel() to stop the computation and
+     * still receive its Report. Cancelling the future also stops the iteration after the current
+     * sweep, but a cancelled future carries no result, so the outcome is only available through
+     * lastReport() once the computation has finished.
+     *
+     * @param options The convergence threshold and the iteration and time limits.
+     * @return A future that receives the outcome of the computation.
+     */
+    QFuture<Report> solveAsync(const Options& options);
+
+    /**
+     * @brief Gets the outcome of the last finished computation.
+     *
+     * Only valid after finished() was emitted, or after the future returned by solveAsync() finished.
+     *
+     * @return The Report of the last solve, default constructed if nothing was solved yet.
+     */
+    Report lastReport() const;
+
+public slots:
+    /**
+     * @brief Requests the running computation to stop.
+     *
+     * The solver checks the request after every sweep and keeps the best iterate found so far.
+     * Safe to call from any thread.
+     */
+    void cancel();
+
 signals:
     /**
      * @brief Signal emitted when the Jacobi solver finishes the computation.
@@ -80,24 +293,111 @@ signals:
      */
     void finished();
 
+    /**
+     * @brief Signal emitted after every iteration.
+     *
+     * Emitted from the thread running the computation.
+     *
+     * @param iteration The number of iterations performed so far.
+     * @param residual The maximum change in the solution vector during the last iteration.
+     */
+    void progress(int iteration, double residual);
+
 private:
     int size;  ///< The size of the system (number of rows and columns).
-    QVector<QVector<double>> matrix;  ///< The matrix of coefficients for the system of equations.
-    QVector<double> b;  ///< The right-hand side vector (constants).
+    QVector<double> ownedMatrix;  ///< The coefficients copied or moved into the solver, stored row by row.
+    MatrixView matrix;  ///< The matrix of coefficients used by the sweeps, owned or viewed.
+    QVector<double> ownedB;  ///< The right-hand side vector copied or moved into the solver.
+    VectorView b;  ///< The right-hand side vector (constants) used by the sweeps, owned or viewed.
+    QVector<double> invDiag;  ///< The reciprocals of the diagonal elements of the matrix.
+    QVector<int> rowFirst;  ///< The first nonzero column of every row of the matrix.
+    QVector<int> rowLast;  ///< The last nonzero column of every row of the matrix.
     QVector<double> x;  ///< The current approximation of the solution.
     QVector<double> xNew;  ///< The updated approximation of the solution after an iteration.
-    QVector<double> xOld;  ///< The previous approximation of the solution.
+    Precision precision;  ///< The precision of the coefficients used by the sweeps.
+    bool refinement;  ///< Whether to finish with a refinement phase in double precision.
+    std::atomic<bool> cancelRequested;  ///< Set by cancel(), checked after every sweep.
+    Options options;  ///< The stopping criteria of the running computation.
+    QPromise<Report>* promise;  ///< The promise of an asynchronous computation, nullptr otherwise.
+    QElapsedTimer timer;  ///< Measures the time spent by the running computation.
+    int iteration;  ///< The number of iterations performed by the running computation.
+    QVector<double> bestX;  ///< The iterate with the smallest maximum change seen so far.
+    double bestResidual;  ///< The maximum change of bestX.
+    QVector<double> history;  ///< The maximum change of every iteration.
+    CheckpointWriter checkpoints;  ///< Writes checkpoints in the background.
+    quint64 systemHash;  ///< Hash of the matrix and b, stored in the checkpoints.
+    int resumeIteration;  ///< The iteration restored by resume(), used by the next solve.
+    bool resumeRefining;  ///< Whether the state restored by resume() belongs to the refinement phase.
+    bool refining;  ///< Whether the sweeps run the refinement phase, stored in the checkpoints.
+    Report latestReport;  ///< The outcome of the last finished computation.
+
+    /**
+     * @brief Computes the reciprocals of the diagonal elements of the matrix.
+     *
+     * The matrix itself is left untouched, every sweep scales its row sums by these values instead.
+     *
+     * @return false if the matrix or b is missing, has the wrong size or a zero on the diagonal.
+     */
+    bool computeInverseDiagonal();
 
     /**
-     * @brief Normalizes the matrix and the right-hand side vector (b).
+     * @brief Checks the iteration limit, the time budget and cancellation requests.
      *
-     * This function ensures that the diagonal elements of the matrix are non-zero by normalizing them.
-     * It modifies the matrix and the vector in place, making the diagonal elements 1 and adjusting the rest.
+     * @param status Set to the reason for stopping, if any.
+     * @return true if the computation should stop, false otherwise.
+     */
+    bool limitReached(Status& status);
+
+    /**
+     * @brief Hands the current state to the background checkpoint writer.
+     *
+     * @param residual The maximum change of the last iteration.
+     */
+    void writeCheckpoint(double residual);
+
+    /**
+     * @brief Computes the first and the last nonzero column of every row of the matrix.
+     */
+    void computeRowExtents();
+
+    /**
+     * @brief Prepares the coefficients for the sweeps in the requested storage type.
+     *
+     * @tparam Scalar The type used to store the coefficients.
+     * @return A view of the matrix for double, a converted copy otherwise, limited to the row extents.
+     */
+    template <typename Scalar>
+    JacobiMatrix<Scalar> prepareMatrix() const;
+
+    /**
+     * @brief Performs one Jacobi sweep from x into xNew.
+     *
+     * @tparam Scalar The type used to store the coefficients.
+     * @param a The coefficients used by the sweep.
+     */
+    template <typename Scalar>
+    void sweep(const JacobiMatrix<Scalar>& a);
+
+    /**
+     * @brief Measures the average wall-clock time of one sweep.
+     *
+     * @tparam Scalar The type used to store the coefficients.
+     * @param a The coefficients used by the sweeps.
+     * @param repeats The number of sweeps to time.
+     * @return The average time of one sweep in seconds.
+     */
+    template <typename Scalar>
+    double timeSweeps(const JacobiMatrix<Scalar>& a, int repeats);
+
+    /**
+     * @brief Runs Jacobi iterations with the given coefficients until a stopping criterion is met.
      *
-     * @param matrix The matrix to normalize.
-     * @param b The right-hand side vector to normalize.
+     * @tparam Scalar The type used to store the coefficients.
+     * @param a The coefficients used by the sweeps.
+     * @return The reason the iteration stopped.
      */
-    void normalizeMatrix(QVector<QVector<double>>& matrix, QVector<double>& b);
+    template <typename Scalar>
+    Status iterate(const JacobiMatrix<Scalar>& a);
 };
 
 #endif // JACOBISOLVER_H
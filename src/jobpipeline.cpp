@@ -0,0 +1,193 @@
+#include "JobPipeline.h"
+#include "MatrixHandler.h"
+#include <QDebug>
+#include <QtConcurrent>
+#include <algorithm>
+
+/**
+ * @brief Constructs a JobPipeline with one parser thread and one job solved at a time.
+ */
+JobPipeline::JobPipeline()
+    : prefetch(0), precision(JacobiSolver::Precision::Double), refinement(false) {
+    parserPool.setMaxThreadCount(1);
+    solverPool.setMaxThreadCount(1);
+}
+
+/**
+ * @brief Sets the number of threads that load files ahead of the solver.
+ *
+ * @param count The number of parser threads, at least 1.
+ */
+void JobPipeline::setParserThreads(int count) {
+    parserPool.setMaxThreadCount(std::max(1, count));
+}
+
+/**
+ * @brief Sets the number of jobs that are solved at the same time.
+ *
+ * @param count The number of concurrent solves, at least 1.
+ */
+void JobPipeline::setConcurrentJobs(int count) {
+    solverPool.setMaxThreadCount(std::max(1, count));
+}
+
+/**
+ * @brief Sets the number of jobs that may be loaded ahead of the oldest unfinished job.
+ *
+ * @param count The prefetch depth, 0 to use twice the number of concurrent solves.
+ */
+void JobPipeline::setPrefetch(int count) {
+    prefetch = std::max(0, count);
+}
+
+/**
+ * @brief Sets the stopping criteria used for every job.
+ */
+void JobPipeline::setOptions(const JacobiSolver::Options& options) {
+    this->options = options;
+}
+
+/**
+ * @brief Sets the storage precision of the coefficients used for every job.
+ */
+void JobPipeline::setPrecision(JacobiSolver::Precision precision) {
+    this->precision = precision;
+}
+
+/**
+ * @brief Enables a refinement phase in double precision after reduced precision solves.
+ */
+void JobPipeline::setRefinement(bool enabled) {
+    refinement = enabled;
+}
+
+/**
+ * @brief Gets the time since the start of run() in seconds.
+ */
+double JobPipeline::now() const {
+    return timer.nsecsElapsed() / 1e9;
+}
+
+/**
+ * @brief Loads and validates the system of a job, runs in the parser pool.
+ *
+ * The checks run here rather than in the solver pool, so a bad file fails early without
+ * taking a solver thread.
+ *
+ * @param index The position of the job in the job list.
+ * @param fileName The input file of the job.
+ * @return The loaded job, with the error set if the file is not a valid system.
+ */
+JobPipeline::Loaded JobPipeline::load(int index, const QString& fileName) const {
+    Loaded job;
+    job.result.index = index;
+    job.result.fileName = fileName;
+    job.result.loadStart = now();
+
+    MatrixHandler handler;
+    if (!handler.loadMatrixFromFile(fileName, job.matrix, job.b)) {
+        job.result.error = "Unable to load matrix or vector from file.";
+    } else if (!handler.validateVector(job.b, job.matrix)
+               || std::any_of(job.matrix.cbegin(), job.matrix.cend(), [&job](const QVector<double>& row) {
+                      return row.size() != job.matrix.size();
+                  })) {
+        job.result.error = "The system is not square.";
+    } else if (!handler.validateMatrix(job.matrix)) {
+        job.result.error = "The matrix is not diagonally dominant.";
+    } else {
+        for (int i = 0; i < job.matrix.size(); ++i) {
+            if (qFuzzyIsNull(job.matrix[i][i])) {  // The same test as JacobiSolver::solve()
+                job.result.error = "The matrix has a zero on the diagonal.";
+                break;
+            }
+        }
+    }
+
+    job.result.size = job.matrix.size();
+    job.result.loadEnd = now();
+    return job;
+}
+
+/**
+ * @brief Solves the system of a loaded job, runs in the solver pool.
+ *
+ * @param job The loaded job, failed jobs are passed through unchanged.
+ * @return The finished job.
+ */
+JobPipeline::Result JobPipeline::solve(Loaded job) const {
+    Result result = std::move(job.result);
+    result.solveStart = now();
+
+    if (result.isOk()) {
+        JacobiSolver solver(result.size);
+        solver.setMatrix(job.matrix);
+        job.matrix.clear();  // The solver keeps its own flattened copy
+        solver.setB(std::move(job.b));
+        solver.setPrecision(precision);
+        solver.setRefinement(refinement);
+        result.report = solver.solve(options);
+        if (result.report.status == JacobiSolver::Status::InvalidInput) {
+            result.error = "The solver rejected the system.";
+        } else {
+            result.x = solver.getResult();
+        }
+    }
+
+    result.solveEnd = now();
+    return result;
+}
+
+/**
+ * @brief Starts loading a job and chains its solve to it.
+ *
+ * @param index The position of the job in the job list.
+ * @param fileName The input file of the job.
+ * @return The future of the finished job.
+ */
+QFuture<JobPipeline::Result> JobPipeline::start(int index, const QString& fileName) {
+    return QtConcurrent::run(&parserPool, [this, index, fileName]() {
+        return load(index, fileName);
+    }).then(&solverPool, [this](Loaded job) {
+        return solve(std::move(job));
+    });
+}
+
+/**
+ * @brief Runs all jobs and hands every result to a callback in the order of the job list.
+ *
+ * A sliding window of jobs is kept in flight. Whenever the oldest job is delivered, the job
+ * one window further is started, so loading always runs ahead of solving by the prefetch depth.
+ *
+ * @param fileNames The input files, one system per file.
+ * @param onResult Called in the calling thread for every job, in order.
+ * @return The number of jobs that failed.
+ */
+int JobPipeline::run(const QStringList& fileNames, const std::function<void(const Result&)>& onResult) {
+    const int count = fileNames.size();
+    const int window = prefetch > 0 ? prefetch : 2 * solverPool.maxThreadCount();
+    timer.start();
+
+    QVector<QFuture<Result>> futures(count);
+    int started = 0;
+    for (; started < std::min(window, count); ++started) {
+        futures[started] = start(started, fileNames[started]);
+    }
+
+    int failed = 0;
+    for (int i = 0; i < count; ++i) {
+        Result result = futures[i].result();
+        futures[i] = QFuture<Result>();  // Release the solution once it was delivered
+
+        if (started < count) {
+            futures[started] = start(started, fileNames[started]);
+            ++started;
+        }
+
+        if (!result.isOk()) {
+            ++failed;
+        }
+        onResult(result);
+    }
+
+    return failed;
+}
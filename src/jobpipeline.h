@@ -0,0 +1,152 @@
+#ifndef JOBPIPELINE_H
+#define JOBPIPELINE_H
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+#include <functional>
+#include "JacobiGlobal.h"
+#include "JacobiSolver.h"
+
+/**
+ * @class JobPipeline
+ * @brief A class for solving many independent systems, each stored in its own file.
+ *
+ * Every job passes through two stages with their own thread pools: the parser pool loads and
+ * validates the file, the solver pool runs the Jacobi method. While the solver pool works on the
+ * current jobs, the parser pool already prefetches the next ones, and several jobs can be solved
+ * at the same time. The number of jobs in flight is bounded, so the memory used does not grow
+ * with the length of the job list.
+ *
+ * Results are delivered in the order of the job list, in the thread that called run().
+ */
+class JACOBI_EXPORT JobPipeline
+{
+public:
+    /**
+     * @struct Result
+     * @brief The outcome and the timing of one job.
+     *
+     * All times are measured in seconds from the start of run().
+     */
+    struct Result {
+        int index = 0;  ///< The position of the job in the job list.
+        QString fileName;  ///< The input file of the job.
+        QString error;  ///< Why the job failed, empty if it was solved.
+        int size = 0;  ///< The number of unknowns.
+        JacobiSolver::Report report;  ///< The outcome of the solve.
+        QVector<double> x;  ///< The solution vector.
+        double loadStart = 0.0;  ///< When the parser pool started loading the file.
+        double loadEnd = 0.0;  ///< When the file was loaded and validated.
+        double solveStart = 0.0;  ///< When the solver pool started the solve.
+        double solveEnd = 0.0;  ///< When the solve finished.
+
+        /**
+         * @brief Checks if the job was loaded and solved.
+         */
+        bool isOk() const { return error.isEmpty(); }
+    };
+
+    /**
+     * @brief Constructs a JobPipeline with one parser thread and one job solved at a time.
+     */
+    JobPipeline();
+
+    /**
+     * @brief Sets the number of threads that load files ahead of the solver.
+     *
+     * @param count The number of parser threads, at least 1.
+     */
+    void setParserThreads(int count);
+
+    /**
+     * @brief Sets the number of jobs that are solved at the same time.
+     *
+     * Jobs solved concurrently also share the global thread pool used for the sweeps,
+     * so values above 1 are meant for many small systems.
+     *
+     * @param count The number of concurrent solves, at least 1.
+     */
+    void setConcurrentJobs(int count);
+
+    /**
+     * @brief Sets the number of jobs that may be loaded ahead of the oldest unfinished job.
+     *
+     * @param count The prefetch depth, 0 to use twice the number of concurrent solves.
+     */
+    void setPrefetch(int count);
+
+    /**
+     * @brief Sets the stopping criteria used for every job.
+     */
+    void setOptions(const JacobiSolver::Options& options);
+
+    /**
+     * @brief Sets the storage precision of the coefficients used for every job.
+     */
+    void setPrecision(JacobiSolver::Precision precision);
+
+    /**
+     * @brief Enables a refinement phase in double precision after reduced precision solves.
+     */
+    void setRefinement(bool enabled);
+
+    /**
+     * @brief Runs all jobs and hands every result to a callback in the order of the job list.
+     *
+     * Blocks until the last job was delivered. A job that cannot be loaded does not stop the others.
+     *
+     * @param fileNames The input files, one system per file.
+     * @param onResult Called in the calling thread for every job, in order.
+     * @return The number of jobs that failed.
+     */
+    int run(const QStringList& fileNames, const std::function<void(const Result&)>& onResult);
+
+private:
+    /**
+     * @struct Loaded
+     * @brief A job between the parser and the solver stage.
+     */
+    struct Loaded {
+        Result result;  ///< The job, with the loading fields filled in.
+        QVector<QVector<double>> matrix;  ///< The matrix of coefficients.
+        QVector<double> b;  ///< The right-hand side vector.
+    };
+
+    QThreadPool parserPool;  ///< Threads that load and validate the files.
+    QThreadPool solverPool;  ///< Threads that solve the loaded systems.
+    int prefetch;  ///< Jobs allowed in flight, 0 for the default.
+    JacobiSolver::Options options;  ///< The stopping criteria of every job.
+    JacobiSolver::Precision precision;  ///< The storage precision of the coefficients.
+    bool refinement;  ///< Whether to refine reduced precision solves in double.
+    QElapsedTimer timer;  ///< Started by run(), read by both stages.
+
+    /**
+     * @brief Starts loading a job and chains its solve to it.
+     *
+     * @param index The position of the job in the job list.
+     * @param fileName The input file of the job.
+     * @return The future of the finished job.
+     */
+    QFuture<Result> start(int index, const QString& fileName);
+
+    /**
+     * @brief Loads and validates the system of a job, runs in the parser pool.
+     */
+    Loaded load(int index, const QString& fileName) const;
+
+    /**
+     * @brief Solves the system of a loaded job, runs in the solver pool.
+     */
+    Result solve(Loaded job) const;
+
+    /**
+     * @brief Gets the time since the start of run() in seconds.
+     */
+    double now() const;
+};
+
+#endif // JOBPIPELINE_H
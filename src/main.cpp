@@ -1,9 +1,221 @@
 #include <QCoreApplication>
 #include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QElapsedTimer>
 #include <QtConcurrent>
+#include <QFutureWatcher>
 #include "MatrixHandler.h"
 #include "JacobiSolver.h"
 #include "ArgumentParser.h"
+#include "BatchJacobiSolver.h"
+#include "JobPipeline.h"
+#include "MatrixReorderer.h"
+#include "ResultWriter.h"
+
+/**
+ * @brief Loads a file with many small systems and solves all of them at once.
+ *
+ * The solutions are written one after the other to standard output or to the `--output` file.
+ * In text format every solution is preceded by a "# system <n>" line, in binary format every
+ * solution is a record with its own header. Systems that could not be solved get an empty record.
+ *
+ * @param handler The matrix handler used for loading and validation.
+ * @param parser The parsed command-line arguments.
+ * @return The exit code of the application, 1 if any system did not converge.
+ */
+static int solveBatch(MatrixHandler& handler, const ArgumentParser& parser) {
+    QVector<QVector<QVector<double>>> matrices;
+    QVector<QVector<double>> bs;
+
+    if (!handler.loadBatchFromFile(parser.getFileName(), matrices, bs)) {
+        qDebug() << "Error: Unable to load systems from file.";
+        return -1;
+    }
+
+    BatchJacobiSolver solver;
+    for (int s = 0; s < matrices.size(); ++s) {
+        if (!handler.validateMatrix(matrices[s]) || !handler.validateVector(bs[s], matrices[s])) {
+            qDebug() << "Error: System" << s + 1 << "is not valid.";
+            return -1;
+        }
+        solver.addSystem(std::move(matrices[s]), std::move(bs[s]));
+    }
+
+    const int maxIterations = parser.getMaxIterations();
+    solver.solve(parser.getEpsilon(), maxIterations > 0 ? maxIterations : 10000, parser.getTimeBudget());
+
+    ResultWriter writer;
+    writer.setFormat(parser.getOutputFormat());
+
+    bool allConverged = true;
+    for (int s = 0; s < solver.systemCount(); ++s) {
+        if (!solver.isValid(s)) {
+            qDebug() << "Error: System" << s + 1 << "could not be solved.";
+        } else {
+            qDebug() << "System" << s + 1 << (solver.hasConverged(s) ? "converged after" : "did not converge after")
+                     << solver.getIterations(s) << "iterations";
+        }
+        allConverged = allConverged && solver.hasConverged(s);
+
+        writer.setAppend(s > 0);  // The first system replaces an existing output file
+        if (!writer.write(parser.getOutputFileName(), solver.getResult(s), QString("system %1").arg(s + 1))) {
+            return -1;
+        }
+    }
+
+    return allConverged ? 0 : 1;
+}
+
+/**
+ * @brief Expands the `--jobs` argument into the list of input files.
+ *
+ * A directory contributes all its `.txt` files in name order. Any other path is read as a list
+ * with one file per line, empty lines and lines starting with '#' are ignored, and relative
+ * names are resolved against the directory of the list.
+ *
+ * @param path The job directory or the job list file.
+ * @param fileNames Reference to a list where the input files will be stored.
+ * @return true if at least one job was found, false otherwise.
+ */
+static bool collectJobs(const QString& path, QStringList& fileNames) {
+    QFileInfo info(path);
+    fileNames.clear();
+
+    if (info.isDir()) {
+        QDir dir(path);
+        for (const QString& name : dir.entryList({"*.txt"}, QDir::Files, QDir::Name)) {
+            fileNames.append(dir.filePath(name));
+        }
+    } else {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            qDebug() << "Error: Unable to open the job list.";
+            return false;
+        }
+        QDir base = info.absoluteDir();
+        QTextStream in(&file);
+        while (!in.atEnd()) {
+            QString line = in.readLine().trimmed();
+            if (line.isEmpty() || line.startsWith('#')) continue;
+            fileNames.append(QDir::isAbsolutePath(line) ? line : base.filePath(line));
+        }
+    }
+
+    if (fileNames.isEmpty()) {
+        qDebug() << "Error: No jobs found.";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Solves one system per file with the parsing of later files overlapped with solving.
+ *
+ * Results are written to standard output in the order of the job list, or into the `--output`
+ * directory with one file per job, named after the job number and the input file.
+ * On standard output every job is introduced by a "# job <n> <file>" line in text format and is
+ * its own record in binary format. Failed jobs get an empty record there, so positions match the
+ * job list. A per-job timing summary follows the last result.
+ *
+ * @param parser The parsed command-line arguments.
+ * @return The exit code of the application.
+ */
+static int solveJobs(const ArgumentParser& parser) {
+    QStringList fileNames;
+    if (!collectJobs(parser.getJobsPath(), fileNames)) {
+        return -1;
+    }
+
+    QDir outputDir;
+    const bool toDirectory = !parser.getOutputFileName().isEmpty();
+    if (toDirectory) {
+        outputDir.setPath(parser.getOutputFileName());
+        if (!outputDir.mkpath(".")) {
+            qDebug() << "Error: Unable to create the output directory.";
+            return -1;
+        }
+    }
+    const QString suffix = parser.getOutputFormat() == ResultWriter::Format::Binary ? ".bin" : ".out";
+
+    JacobiSolver::Options options;
+    options.epsilon = parser.getEpsilon();
+    options.maxIterations = parser.getMaxIterations();
+    options.timeBudget = parser.getTimeBudget();
+
+    JobPipeline pipeline;
+    pipeline.setParserThreads(parser.getParserThreads());
+    pipeline.setConcurrentJobs(parser.getParallelJobs());
+    pipeline.setPrefetch(parser.getPrefetch());
+    pipeline.setOptions(options);
+    pipeline.setPrecision(parser.getPrecision());
+    pipeline.setRefinement(parser.isRefinement());
+
+    ResultWriter writer;
+    writer.setFormat(parser.getOutputFormat());
+    QVector<JobPipeline::Result> summary;
+    bool allConverged = true;
+    bool writeFailed = false;
+
+    int failed = pipeline.run(fileNames, [&](const JobPipeline::Result& result) {
+        qDebug() << "Job" << result.index + 1 << result.fileName;
+        if (!result.isOk()) {
+            qDebug() << "Error:" << result.error;
+        } else if (result.report.status != JacobiSolver::Status::Converged) {
+            allConverged = false;
+            qDebug() << "Warning: Stopped after" << result.report.iterations << "iterations without converging,"
+                     << "best max change:" << result.report.residual;
+        }
+
+        if (toDirectory) {
+            if (result.isOk()) {
+                // The job number keeps the names unique when listed files share a base name
+                QString name = outputDir.filePath(QString("%1_%2%3").arg(result.index + 1, 4, 10, QChar('0'))
+                                                      .arg(QFileInfo(result.fileName).completeBaseName(), suffix));
+                if (!writer.write(name, result.x)) {
+                    writeFailed = true;
+                }
+            }
+        } else {
+            // All jobs share standard output, the header tells where one solution ends
+            QString header = QString("job %1 %2").arg(result.index + 1).arg(result.fileName);
+            if (!writer.write(QString(), result.x, header)) {
+                writeFailed = true;
+            }
+        }
+
+        JobPipeline::Result timing = result;
+        timing.x.clear();
+        summary.append(timing);
+    });
+
+    double wallSeconds = 0.0;
+    double busySeconds = 0.0;
+    qDebug().noquote() << "Job summary (seconds):";
+    qDebug().noquote() << QString("%1  %2  %3  %4  %5  %6  %7")
+                              .arg("job", 5).arg("size", 7).arg("iters", 7)
+                              .arg("load", 9).arg("wait", 9).arg("solve", 9).arg("file");
+    for (const JobPipeline::Result& r : summary) {
+        qDebug().noquote() << QString("%1  %2  %3  %4  %5  %6  %7")
+                                  .arg(r.index + 1, 5).arg(r.size, 7).arg(r.report.iterations, 7)
+                                  .arg(r.loadEnd - r.loadStart, 9, 'f', 4)
+                                  .arg(r.solveStart - r.loadEnd, 9, 'f', 4)
+                                  .arg(r.solveEnd - r.solveStart, 9, 'f', 4)
+                                  .arg(r.isOk() ? r.fileName : r.fileName + " (failed)");
+        wallSeconds = qMax(wallSeconds, r.solveEnd);
+        busySeconds += (r.loadEnd - r.loadStart) + (r.solveEnd - r.solveStart);
+    }
+    qDebug().noquote() << QString("%1 jobs, %2 failed, wall time %3 s, serial load + solve time %4 s")
+                              .arg(summary.size()).arg(failed)
+                              .arg(wallSeconds, 0, 'f', 4).arg(busySeconds, 0, 'f', 4);
+
+    if (failed > 0 || writeFailed) {
+        return -1;
+    }
+    return allConverged ? 0 : 1;
+}
 
 /**
  * @brief The main function that initializes the application, parses arguments,
@@ -11,10 +223,15 @@
  *
  * It performs the following:
  * 1. Parses command-line arguments for the input file and epsilon value.
+ *    In batch mode the file holds many small systems that are solved together instead,
+ *    in `--jobs` mode every listed file holds one system and the files go through a pipeline.
  * 2. Loads the matrix and vector from the specified file.
  * 3. Validates the matrix and vector.
- * 4. Initializes the Jacobi solver and solves the system asynchronously.
- * 5. Displays the results once the computation is finished.
+ * 4. With `--reorder`, applies the Reverse Cuthill-McKee ordering and reports the bandwidth, the profile
+ *    and the sweep time before and after it.
+ * 5. Initializes the Jacobi solver, optionally from a checkpoint, and solves the system
+ *    asynchronously within the optional iteration and time limits.
+ * 6. Writes the results to standard output or to the `--output` file once the computation is finished.
  */
 int main(int argc, char *argv[]) {
     QCoreApplication a(argc, argv);
@@ -25,6 +242,10 @@ int main(int argc, char *argv[]) {
         return -1;
     }
 
+    if (!parser.getJobsPath().isEmpty()) {
+        return solveJobs(parser);
+    }
+
     QString fileName = parser.getFileName();
     double epsilon = parser.getEpsilon();
 
@@ -32,6 +253,11 @@ int main(int argc, char *argv[]) {
     qDebug() << "Epsilon:" << epsilon;
 
     MatrixHandler handler;
+
+    if (parser.isBatch()) {
+        return solveBatch(handler, parser);
+    }
+
     QVector<QVector<double>> matrix;
     QVector<double> b;
 
@@ -48,21 +274,81 @@ int main(int argc, char *argv[]) {
     int size = matrix.size();
 
     JacobiSolver solver(size);
-    solver.setMatrix(matrix);
-    solver.setB(b);
+    solver.setPrecision(parser.getPrecision());
+    solver.setRefinement(parser.isRefinement());
 
-    // Start the computation asynchronously using QtConcurrent
-    QFuture<void> future = QtConcurrent::run([&solver, epsilon]() {
-        solver.solve(epsilon);
-    });
+    // b is only viewed until the reordering is done, then moved into the solver
+    if (!solver.setMatrix(matrix) || !solver.setB(VectorView{b.constData(), int(b.size())})) {
+        qDebug() << "Error: Matrix or vector is not valid.";
+        return -1;
+    }
+
+    QVector<int> perm;
+    if (parser.isReorder()) {
+        MatrixReorderer::Envelope before = MatrixReorderer::measure(matrix);
+        double sweepBefore = solver.measureSweepTime(3);
+
+        QElapsedTimer reorderTimer;
+        reorderTimer.start();
+        MatrixReorderer reorderer;
+        perm = reorderer.computeRcm(matrix);
+        MatrixReorderer::permute(matrix, b, perm);
+        double reorderSeconds = reorderTimer.nsecsElapsed() / 1e9;
+
+        MatrixReorderer::Envelope after = MatrixReorderer::measure(matrix);
+        solver.setMatrix(matrix);
+        solver.setB(VectorView{b.constData(), int(b.size())});
+        double sweepAfter = solver.measureSweepTime(3);
+
+        qDebug() << "Bandwidth:" << before.bandwidth << "->" << after.bandwidth;
+        qDebug() << "Profile:" << before.profile << "->" << after.profile;
+        qDebug() << "Reordering time:" << reorderSeconds << "s";
+        qDebug() << "Sweep time:" << sweepBefore << "s ->" << sweepAfter << "s, speedup"
+                 << (sweepBefore > 0.0 && sweepAfter > 0.0 ? sweepBefore / sweepAfter : 0.0);
+    }
+
+    solver.setB(std::move(b));
+    solver.setCheckpoint(parser.getCheckpointFileName(), parser.getCheckpointInterval());
+
+    if (!parser.getResumeFileName().isEmpty() && !solver.resume(parser.getResumeFileName())) {
+        qDebug() << "Error: Unable to resume from checkpoint.";
+        return -1;
+    }
+
+    JacobiSolver::Options options;
+    options.epsilon = epsilon;
+    options.maxIterations = parser.getMaxIterations();
+    options.timeBudget = parser.getTimeBudget();
 
     // Once the computation is finished, retrieve the result and print it
-    QObject::connect(&solver, &JacobiSolver::finished, [&]() {
+    QFutureWatcher<JacobiSolver::Report> watcher;
+    QObject::connect(&watcher, &QFutureWatcher<JacobiSolver::Report>::finished, [&]() {
+        JacobiSolver::Report report = watcher.result();
+        if (report.status == JacobiSolver::Status::InvalidInput) {
+            qDebug() << "Error: The solver rejected the system.";
+            QCoreApplication::exit(-1);
+            return;
+        }
+        if (report.status != JacobiSolver::Status::Converged) {
+            qDebug() << "Warning: Stopped after" << report.iterations << "iterations without converging,"
+                     << "best max change:" << report.residual;
+        }
+        ResultWriter writer;
+        writer.setFormat(parser.getOutputFormat());
         QVector<double> result = solver.getResult();
-        handler.printResults(result);
-        QCoreApplication::quit();
+        if (!perm.isEmpty()) {
+            result = MatrixReorderer::unpermute(result, perm);
+        }
+        if (!writer.write(parser.getOutputFileName(), result)) {
+            QCoreApplication::exit(-1);
+            return;
+        }
+        QCoreApplication::exit(report.status == JacobiSolver::Status::Converged ? 0 : 1);
     });
 
+    // Start the computation asynchronously using QtConcurrent
+    watcher.setFuture(solver.solveAsync(options));
+
     // Start the Qt event loop to keep the application running
     return a.exec();
 }
@@ -39,33 +39,23 @@ bool MatrixHandler::loadMatrixFromFile(const QString& fileName, QVector<QVector<
         QString line = in.readLine().trimmed();
         if (line.isEmpty()) continue;
 
-        QStringList values = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-        int numCols = values.size();
-        if (numCols < 2) {
-            qDebug() << "Error: The row does not contain enough values.";
-            return false;
-        }
-
         QVector<double> row;
-        bool ok = true; // indicator of transforming strings to doubles
-        for (int i = 0; i < numCols - 1; ++i) {
-            row.append(values[i].toDouble(&ok));
-            if (!ok) {
-                qDebug() << "Error: Invalid value in the row.";
-                return false;
-            }
+        double rhs = 0.0;
+        if (!parseRow(line, row, rhs)) {
+            return false;
         }
 
         matrix.append(row);
-        b.append(values.last().toDouble(&ok));
-        if (!ok) {
-            qDebug() << "Error: Invalid value in vector b.";
-            return false;
-        }
+        b.append(rhs);
     }
 
     file.close();
 
+    if (matrix.isEmpty()) {
+        qDebug() << "Error: The file does not contain any rows.";
+        return false;
+    }
+
     // Check if the matrix has a consistent number of columns
     int expectedCols = matrix.first().size();
     for (const auto& row : matrix) {
@@ -79,16 +69,131 @@ bool MatrixHandler::loadMatrixFromFile(const QString& fileName, QVector<QVector<
 }
 
 
+/**
+ * @brief Loads many small systems from a single text file.
+ *
+ * Every system is written in the same format as for loadMatrixFromFile(). Systems are separated
+ * by one or more empty lines and every system must be square.
+ *
+ * @param fileName The name of the file to be loaded.
+ * @param matrices Reference to a vector where the matrices of the systems will be stored.
+ * @param bs Reference to a vector where the right-hand side vectors of the systems will be stored.
+ * @return true if all systems were successfully loaded, false otherwise.
+ */
+bool MatrixHandler::loadBatchFromFile(const QString& fileName, QVector<QVector<QVector<double>>>& matrices,
+                                      QVector<QVector<double>>& bs) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Error: Unable to open the file.";
+        return false;
+    }
+
+    QTextStream in(&file);
+    matrices.clear();
+    bs.clear();
+
+    QVector<QVector<double>> matrix;
+    QVector<double> b;
+
+    // Store the system collected so far, an empty line or the end of the file closes it
+    auto closeSystem = [&]() {
+        if (matrix.isEmpty()) return true;
+        for (const auto& row : matrix) {
+            if (row.size() != matrix.size()) {
+                qDebug() << "Error: System" << matrices.size() + 1 << "is not square.";
+                return false;
+            }
+        }
+        matrices.append(matrix);
+        bs.append(b);
+        matrix.clear();
+        b.clear();
+        return true;
+    };
+
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        if (line.isEmpty()) {
+            if (!closeSystem()) return false;
+            continue;
+        }
+
+        QVector<double> row;
+        double rhs = 0.0;
+        if (!parseRow(line, row, rhs)) {
+            return false;
+        }
+
+        matrix.append(row);
+        b.append(rhs);
+    }
+
+    file.close();
+
+    if (!closeSystem()) return false;
+
+    if (matrices.isEmpty()) {
+        qDebug() << "Error: The file does not contain any system.";
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Parses one line of an input file into a matrix row and a right-hand side value.
+ *
+ * @param line The trimmed, non-empty line to parse.
+ * @param row Reference to a vector where the coefficients of the row will be stored.
+ * @param rhs Reference to a value where the right-hand side will be stored.
+ * @return true if the line contains at least two valid numbers, false otherwise.
+ */
+bool MatrixHandler::parseRow(const QString& line, QVector<double>& row, double& rhs) {
+    QStringList values = line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+    int numCols = values.size();
+    if (numCols < 2) {
+        qDebug() << "Error: The row does not contain enough values.";
+        return false;
+    }
+
+    bool ok = true; // indicator of transforming strings to doubles
+    for (int i = 0; i < numCols - 1; ++i) {
+        row.append(values[i].toDouble(&ok));
+        if (!ok) {
+            qDebug() << "Error: Invalid value in the row.";
+            return false;
+        }
+    }
+
+    rhs = values.last().toDouble(&ok);
+    if (!ok) {
+        qDebug() << "Error: Invalid value in vector b.";
+        return false;
+    }
+
+    return true;
+}
+
+
 /**
  * @brief Validates whether a given matrix is diagonally dominant.
  *
  * A matrix is diagonally dominant if, for each row, the absolute value of the diagonal
  * element is greater than or equal to the sum of the absolute values of the non-diagonal elements.
+ * Non-square matrices are rejected as well.
  *
  * @param matrix The matrix to be validated.
- * @return true if the matrix is diagonally dominant, false otherwise.
+ * @return true if the matrix is square and diagonally dominant, false otherwise.
  */
 bool MatrixHandler::validateMatrix(const QVector<QVector<double>>& matrix) {
+    for (const auto& row : matrix) {
+        if (row.size() != matrix.size()) {
+            qDebug() << "Error: The matrix is not square.";
+            return false;
+        }
+    }
+
     for (int i = 0; i < matrix.size(); ++i) {
         double diag = matrix[i][i];
         double sum = 0.0;
@@ -3,12 +3,13 @@
 
 #include <QString>
 #include <QVector>
+#include "JacobiGlobal.h"
 
 /**
  * @class MatrixHandler
  * @brief A class for handling matrix operations, including loading from a file, validation, and result output.
  */
-class MatrixHandler
+class JACOBI_EXPORT MatrixHandler
 {
 public:
     MatrixHandler();
@@ -27,14 +28,30 @@ public:
     bool loadMatrixFromFile(const QString& fileName, QVector<QVector<double>>& matrix, QVector<double>& b);
 
 
+    /**
+     * @brief Loads many small systems from a single text file.
+     *
+     * Every system is written in the same format as for loadMatrixFromFile(). Systems are separated
+     * by one or more empty lines and every system must be square.
+     *
+     * @param fileName The name of the file to be loaded.
+     * @param matrices Reference to a vector where the matrices of the systems will be stored.
+     * @param bs Reference to a vector where the right-hand side vectors of the systems will be stored.
+     * @return true if all systems were successfully loaded, false otherwise.
+     */
+    bool loadBatchFromFile(const QString& fileName, QVector<QVector<QVector<double>>>& matrices,
+                           QVector<QVector<double>>& bs);
+
+
     /**
      * @brief Validates whether a given matrix is diagonally dominant.
      *
      * A matrix is diagonally dominant if, for each row, the absolute value of the diagonal
      * element is greater than or equal to the sum of the absolute values of the non-diagonal elements.
+     * Non-square matrices are rejected as well.
      *
      * @param matrix The matrix to be validated.
-     * @return true if the matrix is diagonally dominant, false otherwise.
+     * @return true if the matrix is square and diagonally dominant, false otherwise.
      */
     bool validateMatrix(const QVector<QVector<double>>& matrix);
 
@@ -57,6 +74,15 @@ public:
     void printResults(const QVector<double>& results);
 
 private:
+    /**
+     * @brief Parses one line of an input file into a matrix row and a right-hand side value.
+     *
+     * @param line The trimmed, non-empty line to parse.
+     * @param row Reference to a vector where the coefficients of the row will be stored.
+     * @param rhs Reference to a value where the right-hand side will be stored.
+     * @return true if the line contains at least two valid numbers, false otherwise.
+     */
+    bool parseRow(const QString& line, QVector<double>& row, double& rhs);
 };
 
 #endif // MATRIXHANDLER_H
@@ -0,0 +1,242 @@
+#include "MatrixReorderer.h"
+#include <QtConcurrent>
+#include <algorithm>
+#include <numeric>
+
+/**
+ * @class MatrixReorderer
+ * @brief A class to compute and apply the Reverse Cuthill-McKee ordering of a matrix.
+ */
+
+namespace {
+
+/**
+ * @brief Returns the indices 0 .. n - 1, used to distribute rows over the thread pool.
+ */
+QVector<int> rowIndices(int n) {
+    QVector<int> rows(n);
+    std::iota(rows.begin(), rows.end(), 0);
+    return rows;
+}
+
+} // namespace
+
+/**
+ * @brief Default constructor for the MatrixReorderer class.
+ */
+MatrixReorderer::MatrixReorderer() {}
+
+/**
+ * @brief Measures the bandwidth and the profile of a matrix.
+ *
+ * @param matrix The square matrix to measure.
+ * @return The bandwidth and the profile.
+ */
+MatrixReorderer::Envelope MatrixReorderer::measure(const QVector<QVector<double>>& matrix) {
+    QVector<Envelope> rows = QtConcurrent::blockingMapped<QVector<Envelope>>(rowIndices(matrix.size()), [&matrix](int i) {
+        const QVector<double>& row = matrix[i];
+        int first = i;
+        int last = i;
+        for (int j = 0; j < row.size(); ++j) {
+            if (row[j] != 0.0) {
+                first = std::min(first, j);
+                last = std::max(last, j);
+            }
+        }
+        Envelope e;
+        e.bandwidth = std::max(i - first, last - i);
+        e.profile = i - first;
+        return e;
+    });
+
+    Envelope total;
+    for (const Envelope& e : rows) {
+        total.bandwidth = std::max(total.bandwidth, e.bandwidth);
+        total.profile += e.profile;
+    }
+    return total;
+}
+
+/**
+ * @brief Builds the adjacency lists of the symmetric nonzero pattern of a matrix.
+ *
+ * Both passes run in parallel over the rows: the first collects the neighbours, the second
+ * sorts every list by increasing degree, which is the order Cuthill-McKee visits them in.
+ */
+void MatrixReorderer::buildAdjacency(const QVector<QVector<double>>& matrix) {
+    const int n = matrix.size();
+
+    adjacency = QtConcurrent::blockingMapped<QVector<QVector<int>>>(rowIndices(n), [&matrix, n](int i) {
+        QVector<int> neighbours;
+        for (int j = 0; j < n; ++j) {
+            if (j != i && (matrix[i][j] != 0.0 || matrix[j][i] != 0.0)) {
+                neighbours.append(j);
+            }
+        }
+        return neighbours;
+    });
+
+    const QVector<QVector<int>>& lists = adjacency;
+    QtConcurrent::blockingMap(adjacency, [&lists](QVector<int>& neighbours) {
+        std::stable_sort(neighbours.begin(), neighbours.end(), [&lists](int a, int b) {
+            return lists[a].size() < lists[b].size();
+        });
+    });
+}
+
+/**
+ * @brief Runs a breadth-first search and records the level of every reached node.
+ *
+ * Expects the level of every node of the component to be -1 on entry.
+ *
+ * @param start The node to start from.
+ * @return The nodes reached, in the order they were visited.
+ */
+QVector<int> MatrixReorderer::levelStructure(int start) {
+    QVector<int> order;
+    order.append(start);
+    level[start] = 0;
+
+    for (qsizetype head = 0; head < order.size(); ++head) {
+        int v = order[head];
+        for (int w : adjacency[v]) {
+            if (level[w] < 0) {
+                level[w] = level[v] + 1;
+                order.append(w);
+            }
+        }
+    }
+    return order;
+}
+
+/**
+ * @brief Finds a node of the same component with a large eccentricity (George-Liu heuristic).
+ *
+ * Starting from the given node, repeatedly moves to the lowest-degree node of the deepest
+ * level while that increases the depth of the level structure.
+ *
+ * @param start Any node of the component.
+ * @return A pseudo-peripheral node of the component.
+ */
+int MatrixReorderer::findPseudoPeripheral(int start) {
+    int node = start;
+    QVector<int> order = levelStructure(node);
+    int eccentricity = level[order.last()];
+
+    while (true) {
+        int candidate = -1;
+        for (qsizetype k = order.size() - 1; k >= 0 && level[order[k]] == eccentricity; --k) {
+            if (candidate < 0 || adjacency[order[k]].size() < adjacency[candidate].size()) {
+                candidate = order[k];
+            }
+        }
+
+        for (int v : order) level[v] = -1;
+
+        QVector<int> candidateOrder = levelStructure(candidate);
+        int candidateEccentricity = level[candidateOrder.last()];
+
+        if (candidateEccentricity <= eccentricity) {
+            for (int v : candidateOrder) level[v] = -1;
+            return node;
+        }
+
+        node = candidate;
+        order = candidateOrder;
+        eccentricity = candidateEccentricity;
+    }
+}
+
+/**
+ * @brief Computes the Reverse Cuthill-McKee ordering of a matrix.
+ *
+ * Components are started from their lowest-degree node, moved to a pseudo-peripheral node first.
+ *
+ * @param matrix The square matrix to reorder.
+ * @return The permutation, row k of the reordered matrix is row perm[k] of the original.
+ */
+QVector<int> MatrixReorderer::computeRcm(const QVector<QVector<double>>& matrix) {
+    const int n = matrix.size();
+    buildAdjacency(matrix);
+    level.fill(-1, n);
+
+    QVector<int> byDegree = rowIndices(n);
+    std::stable_sort(byDegree.begin(), byDegree.end(), [this](int a, int b) {
+        return adjacency[a].size() < adjacency[b].size();
+    });
+
+    QVector<bool> visited(n, false);
+    QVector<int> order;
+    order.reserve(n);
+
+    for (int candidate : byDegree) {
+        if (visited[candidate]) continue;
+
+        int start = findPseudoPeripheral(candidate);
+        visited[start] = true;
+        order.append(start);
+
+        // Cuthill-McKee: breadth-first, neighbours in the order of increasing degree
+        for (qsizetype head = order.size() - 1; head < order.size(); ++head) {
+            for (int w : adjacency[order[head]]) {
+                if (!visited[w]) {
+                    visited[w] = true;
+                    order.append(w);
+                }
+            }
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+
+    adjacency.clear();
+    level.clear();
+    return order;
+}
+
+/**
+ * @brief Applies a symmetric permutation to a system.
+ *
+ * The rows of the permuted matrix are gathered in parallel.
+ *
+ * @param matrix The matrix, replaced by P * A * P^T.
+ * @param b The right-hand side vector, replaced by P * b.
+ * @param perm The permutation from computeRcm().
+ */
+void MatrixReorderer::permute(QVector<QVector<double>>& matrix, QVector<double>& b, const QVector<int>& perm) {
+    const int n = perm.size();
+    const QVector<QVector<double>>& original = matrix;
+
+    QVector<QVector<double>> permuted = QtConcurrent::blockingMapped<QVector<QVector<double>>>(rowIndices(n),
+        [&original, &perm, n](int k) {
+            const QVector<double>& source = original[perm[k]];
+            QVector<double> row(n);
+            for (int l = 0; l < n; ++l) {
+                row[l] = source[perm[l]];
+            }
+            return row;
+        });
+
+    QVector<double> permutedB(n);
+    for (int k = 0; k < n; ++k) {
+        permutedB[k] = b[perm[k]];
+    }
+
+    matrix = std::move(permuted);
+    b = std::move(permutedB);
+}
+
+/**
+ * @brief Maps the solution of a permuted system back to the original order.
+ *
+ * @param x The solution of the permuted system.
+ * @param perm The permutation that was applied to the system.
+ * @return The solution of the original system.
+ */
+QVector<double> MatrixReorderer::unpermute(const QVector<double>& x, const QVector<int>& perm) {
+    QVector<double> result(x.size());
+    for (int k = 0; k < perm.size(); ++k) {
+        result[perm[k]] = x[k];
+    }
+    return result;
+}
@@ -0,0 +1,98 @@
+#ifndef MATRIXREORDERER_H
+#define MATRIXREORDERER_H
+
+#include <QVector>
+#include "JacobiGlobal.h"
+
+/**
+ * @class MatrixReorderer
+ * @brief A class for reducing the bandwidth of a matrix with the Reverse Cuthill-McKee ordering.
+ *
+ * The ordering is computed on the symmetric nonzero pattern of the matrix (a[i][j] != 0 or
+ * a[j][i] != 0). Applying it to the matrix and the right-hand side moves the nonzero entries
+ * towards the diagonal, which shrinks the range of columns the solver has to visit in every row.
+ * The solution of the permuted system has to be permuted back with unpermute().
+ *
+ * Permutations map new indices to old ones: row k of the permuted matrix is row perm[k] of the original.
+ */
+class JACOBI_EXPORT MatrixReorderer
+{
+public:
+    /**
+     * @struct Envelope
+     * @brief The bandwidth and the profile of a matrix.
+     */
+    struct Envelope {
+        int bandwidth = 0;  ///< The largest |i - j| over all nonzero entries a[i][j].
+        qint64 profile = 0;  ///< The sum over all rows of the distance from the first nonzero entry to the diagonal.
+    };
+
+    MatrixReorderer();
+
+    /**
+     * @brief Measures the bandwidth and the profile of a matrix.
+     *
+     * The rows are measured in parallel.
+     *
+     * @param matrix The square matrix to measure.
+     * @return The bandwidth and the profile.
+     */
+    static Envelope measure(const QVector<QVector<double>>& matrix);
+
+    /**
+     * @brief Computes the Reverse Cuthill-McKee ordering of a matrix.
+     *
+     * The adjacency lists of the nonzero pattern are built in parallel, then every connected
+     * component is traversed breadth-first from a pseudo-peripheral node, visiting neighbours
+     * in the order of increasing degree. The resulting order is reversed.
+     *
+     * @param matrix The square matrix to reorder.
+     * @return The permutation, row k of the reordered matrix is row perm[k] of the original.
+     */
+    QVector<int> computeRcm(const QVector<QVector<double>>& matrix);
+
+    /**
+     * @brief Applies a symmetric permutation to a system.
+     *
+     * @param matrix The matrix, replaced by P * A * P^T.
+     * @param b The right-hand side vector, replaced by P * b.
+     * @param perm The permutation from computeRcm().
+     */
+    static void permute(QVector<QVector<double>>& matrix, QVector<double>& b, const QVector<int>& perm);
+
+    /**
+     * @brief Maps the solution of a permuted system back to the original order.
+     *
+     * @param x The solution of the permuted system.
+     * @param perm The permutation that was applied to the system.
+     * @return The solution of the original system.
+     */
+    static QVector<double> unpermute(const QVector<double>& x, const QVector<int>& perm);
+
+private:
+    QVector<QVector<int>> adjacency;  ///< The neighbours of every node, sorted by increasing degree.
+    QVector<int> level;  ///< Breadth-first search level of every node, -1 if not reached.
+
+    /**
+     * @brief Builds the adjacency lists of the symmetric nonzero pattern of a matrix.
+     */
+    void buildAdjacency(const QVector<QVector<double>>& matrix);
+
+    /**
+     * @brief Finds a node of the same component with a large eccentricity (George-Liu heuristic).
+     *
+     * @param start Any node of the component.
+     * @return A pseudo-peripheral node of the component.
+     */
+    int findPseudoPeripheral(int start);
+
+    /**
+     * @brief Runs a breadth-first search and records the level of every reached node.
+     *
+     * @param start The node to start from.
+     * @return The nodes reached, in the order they were visited.
+     */
+    QVector<int> levelStructure(int start);
+};
+
+#endif // MATRIXREORDERER_H
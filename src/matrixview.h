@@ -0,0 +1,36 @@
+#ifndef MATRIXVIEW_H
+#define MATRIXVIEW_H
+
+#include <QtGlobal>
+
+/**
+ * @struct VectorView
+ * @brief A non-owning view of a contiguous vector of doubles owned by the caller.
+ */
+struct VectorView
+{
+    const double* data = nullptr;  ///< Pointer to the first element.
+    int size = 0;  ///< The number of elements.
+};
+
+/**
+ * @struct MatrixView
+ * @brief A non-owning view of a row-major matrix of doubles owned by the caller.
+ *
+ * Consecutive rows start `stride` elements apart, so a view can also cover the coefficient part
+ * of an augmented matrix [A | b] by using a stride of cols + 1.
+ */
+struct MatrixView
+{
+    const double* data = nullptr;  ///< Pointer to the first element of the first row.
+    int rows = 0;  ///< The number of rows.
+    int cols = 0;  ///< The number of columns.
+    qsizetype stride = 0;  ///< The distance between the starts of two consecutive rows.
+
+    /**
+     * @brief Gets a pointer to the first element of a row.
+     */
+    const double* row(int i) const { return data + qsizetype(i) * stride; }
+};
+
+#endif // MATRIXVIEW_H
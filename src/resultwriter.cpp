@@ -0,0 +1,238 @@
+#include "ResultWriter.h"
+#include <QDebug>
+#include <QFile>
+#include <QThread>
+#include <QtConcurrent>
+#include <QtEndian>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr qsizetype ValuesPerChunk = 1 << 16;  ///< Values formatted or copied by one task.
+constexpr qsizetype MaxCharsPerValue = 32;  ///< Upper bound of a shortest round-trip double plus '\n'.
+constexpr qsizetype HeaderSize = 16;  ///< Size of the binary header.
+constexpr char BinaryMagic[8] = {'J', 'A', 'C', 'O', 'B', 'I', 'X', '1'};
+
+/**
+ * @struct TextChunk
+ * @brief A range of values and its text representation.
+ */
+struct TextChunk {
+    const double* values;
+    qsizetype count;
+    QByteArray text;
+};
+
+/**
+ * @brief Formats a chunk of values, one per line, with std::to_chars.
+ */
+void formatChunk(TextChunk& chunk) {
+    chunk.text.resize(chunk.count * MaxCharsPerValue);
+    char* out = chunk.text.data();
+    char* end = out + chunk.text.size();
+    for (qsizetype i = 0; i < chunk.count; ++i) {
+        out = std::to_chars(out, end, chunk.values[i]).ptr;
+        *out++ = '\n';
+    }
+    chunk.text.resize(out - chunk.text.constData());
+}
+
+/**
+ * @brief Splits the next values into chunks for one round of parallel formatting.
+ *
+ * @param values Pointer to the first value of the vector.
+ * @param count The number of values in the vector.
+ * @param next The first value not taken yet, advanced past the returned chunks.
+ * @return Up to a few chunks per thread, empty when all values were taken.
+ */
+QVector<TextChunk> takeChunks(const double* values, qsizetype count, qsizetype& next) {
+    const qsizetype chunksPerRound = qMax(1, QThread::idealThreadCount()) * 4;
+    QVector<TextChunk> chunks;
+    while (next < count && chunks.size() < chunksPerRound) {
+        qsizetype n = qMin(ValuesPerChunk, count - next);
+        chunks.append(TextChunk{values + next, n, QByteArray()});
+        next += n;
+    }
+    return chunks;
+}
+
+/**
+ * @brief Opens the output file, or standard output for an empty name or "-".
+ */
+bool openOutput(QFile& file, const QString& fileName, QIODevice::OpenMode mode, bool append) {
+    if (fileName.isEmpty() || fileName == "-") {
+        return file.open(stdout, QIODevice::WriteOnly);
+    }
+    file.setFileName(fileName);
+    return file.open(mode | (append ? QIODevice::Append : QIODevice::Truncate));
+}
+
+/**
+ * @brief Fills the 16-byte binary header.
+ */
+void fillHeader(uchar* header, qsizetype count) {
+    std::memcpy(header, BinaryMagic, sizeof(BinaryMagic));
+    qToLittleEndian<quint64>(quint64(count), header + sizeof(BinaryMagic));
+}
+
+} // namespace
+
+/**
+ * @brief Constructs a ResultWriter that writes text.
+ */
+ResultWriter::ResultWriter() : format(Format::Text), append(false) {}
+
+/**
+ * @brief Sets the output format.
+ *
+ * @param f The format used by the next write().
+ */
+void ResultWriter::setFormat(Format f) {
+    format = f;
+}
+
+/**
+ * @brief Makes the next writes append to the output file instead of replacing it.
+ *
+ * Standard output is always appended to.
+ *
+ * @param enabled true to append, false to replace the file (the default).
+ */
+void ResultWriter::setAppend(bool enabled) {
+    append = enabled;
+}
+
+/**
+ * @brief Writes a solution vector.
+ *
+ * @param fileName The output file, an empty name or "-" writes to standard output.
+ * @param values Pointer to the first value.
+ * @param count The number of values.
+ * @param header A line written before the values in text format, without the leading "# ".
+ *               Ignored in binary format and if empty.
+ * @return true if all values were written, false otherwise.
+ */
+bool ResultWriter::write(const QString& fileName, const double* values, qsizetype count, const QString& header) {
+    if (format == Format::Binary) {
+        return writeBinary(fileName, values, count);
+    }
+    return writeText(fileName, values, count, header);
+}
+
+/**
+ * @brief Writes a solution vector.
+ *
+ * @param fileName The output file, an empty name or "-" writes to standard output.
+ * @param values The solution vector.
+ * @param header A line written before the values in text format, without the leading "# ".
+ *               Ignored in binary format and if empty.
+ * @return true if all values were written, false otherwise.
+ */
+bool ResultWriter::write(const QString& fileName, const QVector<double>& values, const QString& header) {
+    return write(fileName, values.constData(), values.size(), header);
+}
+
+/**
+ * @brief Writes the values as text, formatting chunks of values in parallel.
+ *
+ * The values are processed in rounds of a few chunks per thread. While one round is written,
+ * the next one is already being formatted, and the memory used stays bounded by two rounds.
+ */
+bool ResultWriter::writeText(const QString& fileName, const double* values, qsizetype count, const QString& header) {
+    QFile file;
+    if (!openOutput(file, fileName, QIODevice::WriteOnly, append)) {
+        qDebug() << "Error: Unable to open the output file.";
+        return false;
+    }
+
+    if (!header.isEmpty()) {
+        const QByteArray line = "# " + header.toUtf8() + '\n';
+        if (file.write(line) != line.size()) {
+            qDebug() << "Error: Unable to write the results.";
+            return false;
+        }
+    }
+
+    qsizetype next = 0;
+    QVector<TextChunk> current = takeChunks(values, count, next);
+    QtConcurrent::blockingMap(current, formatChunk);
+
+    while (!current.isEmpty()) {
+        QVector<TextChunk> upcoming = takeChunks(values, count, next);
+        QFuture<void> formatting = QtConcurrent::map(upcoming, formatChunk);
+
+        for (const TextChunk& chunk : current) {
+            if (file.write(chunk.text) != chunk.text.size()) {
+                qDebug() << "Error: Unable to write the results.";
+                formatting.waitForFinished();
+                return false;
+            }
+        }
+
+        formatting.waitForFinished();
+        current = std::move(upcoming);
+    }
+
+    return file.flush();
+}
+
+/**
+ * @brief Writes the values in the binary format.
+ *
+ * A regular file is resized to its final size and memory mapped, and the values are copied
+ * into the map in parallel chunks. When appending, only the new record at the end of the file
+ * is mapped. Standard output receives the same bytes through write().
+ */
+bool ResultWriter::writeBinary(const QString& fileName, const double* values, qsizetype count) {
+    QFile file;
+    if (!openOutput(file, fileName, QIODevice::ReadWrite, append)) {
+        qDebug() << "Error: Unable to open the output file.";
+        return false;
+    }
+
+    const qsizetype totalSize = HeaderSize + count * qsizetype(sizeof(double));
+    const bool toStdout = fileName.isEmpty() || fileName == "-";
+    const qint64 offset = toStdout || file.isSequential() ? 0 : file.size();
+
+    if (toStdout || file.isSequential() || !file.resize(offset + totalSize)) {
+        // Standard output may be a pipe or a terminal, stream the values in large blocks instead
+        QByteArray block(HeaderSize, Qt::Uninitialized);
+        fillHeader(reinterpret_cast<uchar*>(block.data()), count);
+        if (file.write(block) != block.size()) {
+            qDebug() << "Error: Unable to write the results.";
+            return false;
+        }
+        for (qsizetype first = 0; first < count; first += ValuesPerChunk) {
+            qsizetype n = qMin(ValuesPerChunk, count - first);
+            block.resize(n * qsizetype(sizeof(double)));
+            qToLittleEndian<double>(values + first, n, block.data());
+            if (file.write(block) != block.size()) {
+                qDebug() << "Error: Unable to write the results.";
+                return false;
+            }
+        }
+        return file.flush();
+    }
+
+    uchar* map = file.map(offset, totalSize);
+    if (!map) {
+        qDebug() << "Error: Unable to map the output file.";
+        return false;
+    }
+
+    fillHeader(map, count);
+
+    QVector<qsizetype> chunkStarts;
+    for (qsizetype first = 0; first < count; first += ValuesPerChunk) {
+        chunkStarts.append(first);
+    }
+    uchar* data = map + HeaderSize;
+    QtConcurrent::blockingMap(chunkStarts, [values, count, data](qsizetype first) {
+        qsizetype n = qMin(ValuesPerChunk, count - first);
+        qToLittleEndian<double>(values + first, n, data + first * qsizetype(sizeof(double)));
+    });
+
+    return file.unmap(map);
+}
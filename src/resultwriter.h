@@ -0,0 +1,97 @@
+#ifndef RESULTWRITER_H
+#define RESULTWRITER_H
+
+#include <QString>
+#include <QVector>
+#include "JacobiGlobal.h"
+
+/**
+ * @class ResultWriter
+ * @brief A class for writing large solution vectors to a file or to standard output.
+ *
+ * Two formats are supported:
+ * - Text: one value per line in the shortest form that reads back to the same double.
+ *   The values are formatted with std::to_chars in parallel chunks and written in large blocks.
+ * - Binary: a 16-byte header followed by the raw values, meant to be read (or memory mapped)
+ *   directly by downstream tools. Files are written through a memory map of the output file.
+ *
+ * Binary layout, all numbers little-endian:
+ *
+ *     offset 0   8 bytes   magic "JACOBIX1"
+ *     offset 8   quint64   number of values n
+ *     offset 16  n double  the solution vector
+ *
+ * Several vectors can be written to the same output. In text format every vector may be
+ * introduced by a header line starting with "# ", binary records simply follow each other
+ * and are told apart by their own headers.
+ */
+class JACOBI_EXPORT ResultWriter
+{
+public:
+    /**
+     * @brief The output format.
+     */
+    enum class Format {
+        Text,   ///< One value per line.
+        Binary  ///< Header followed by raw little-endian doubles.
+    };
+
+    /**
+     * @brief Constructs a ResultWriter that writes text.
+     */
+    ResultWriter();
+
+    /**
+     * @brief Sets the output format.
+     *
+     * @param f The format used by the next write().
+     */
+    void setFormat(Format f);
+
+    /**
+     * @brief Makes the next writes append to the output file instead of replacing it.
+     *
+     * @param enabled true to append, false to replace the file (the default).
+     */
+    void setAppend(bool enabled);
+
+    /**
+     * @brief Writes a solution vector.
+     *
+     * @param fileName The output file, an empty name or "-" writes to standard output.
+     * @param values Pointer to the first value.
+     * @param count The number of values.
+     * @param header A line written before the values in text format, without the leading "# ".
+     *               Ignored in binary format and if empty.
+     * @return true if all values were written, false otherwise.
+     */
+    bool write(const QString& fileName, const double* values, qsizetype count,
+               const QString& header = QString());
+
+    /**
+     * @brief Writes a solution vector.
+     *
+     * @param fileName The output file, an empty name or "-" writes to standard output.
+     * @param values The solution vector.
+     * @param header A line written before the values in text format, without the leading "# ".
+     *               Ignored in binary format and if empty.
+     * @return true if all values were written, false otherwise.
+     */
+    bool write(const QString& fileName, const QVector<double>& values, const QString& header = QString());
+
+private:
+    Format format;  ///< The output format.
+    bool append;  ///< Whether writes append to the output file.
+
+    /**
+     * @brief Writes the values as text, formatting chunks of values in parallel.
+     */
+    bool writeText(const QString& fileName, const double* values, qsizetype count, const QString& header);
+
+    /**
+     * @brief Writes the values in the binary format, through a memory map for regular files.
+     */
+    bool writeBinary(const QString& fileName, const double* values, qsizetype count);
+};
+
+#endif // RESULTWRITER_H
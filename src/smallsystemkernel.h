@@ -0,0 +1,115 @@
+#ifndef SMALLSYSTEMKERNEL_H
+#define SMALLSYSTEMKERNEL_H
+
+#include <array>
+#include <utility>
+
+/**
+ * @namespace SmallSystemKernel
+ * @brief Jacobi sweep kernels for packs of small systems stored as structure of arrays.
+ *
+ * A pack holds up to `Lanes` independent systems of the same size n. Every coefficient is
+ * stored for all lanes next to each other, so the innermost loop runs over systems and
+ * maps directly onto SIMD registers:
+ *
+ *     a[(i * n + j) * Lanes + l]  coefficient (i, j) of system l
+ *     b[i * Lanes + l]            right-hand side i of system l
+ *     x[i * Lanes + l]            unknown i of system l
+ *
+ * The coefficients are expected to be normalized (unit diagonal moved to the left-hand side,
+ * diagonal entries set to zero), so one sweep is simply xNew = b - A * xOld.
+ */
+namespace SmallSystemKernel {
+
+constexpr int Lanes = 8;               ///< Number of systems solved together by one kernel call.
+constexpr int MinSpecializedSize = 2;  ///< Smallest size with a compile-time specialized kernel.
+constexpr int MaxSpecializedSize = 32; ///< Largest size with a compile-time specialized kernel.
+
+/**
+ * @brief Signature shared by the specialized kernels and the generic fallback.
+ */
+using SweepFunction = void (*)(int n, const double* a, const double* b, const double* xOld, double* xNew);
+
+/**
+ * @brief Subtracts a * x from the accumulator for every lane.
+ */
+inline void subtractLanes(const double* a, const double* x, double* acc)
+{
+    for (int l = 0; l < Lanes; ++l) {
+        acc[l] -= a[l] * x[l];
+    }
+}
+
+/**
+ * @brief Jacobi sweep for packs of size N, with the column loop of every row fully unrolled.
+ */
+template <int N>
+struct FixedSweep
+{
+    template <std::size_t... J>
+    static inline void row(const double* aRow, const double* xOld, double* acc, std::index_sequence<J...>)
+    {
+        (subtractLanes(aRow + J * Lanes, xOld + J * Lanes, acc), ...);
+    }
+
+    static void run(int, const double* a, const double* b, const double* xOld, double* xNew)
+    {
+        for (int i = 0; i < N; ++i) {
+            double acc[Lanes];
+            for (int l = 0; l < Lanes; ++l) {
+                acc[l] = b[i * Lanes + l];
+            }
+            row(a + i * N * Lanes, xOld, acc, std::make_index_sequence<N>());
+            for (int l = 0; l < Lanes; ++l) {
+                xNew[i * Lanes + l] = acc[l];
+            }
+        }
+    }
+};
+
+/**
+ * @brief Generic Jacobi sweep used for sizes without a specialized kernel.
+ */
+inline void genericSweep(int n, const double* a, const double* b, const double* xOld, double* xNew)
+{
+    for (int i = 0; i < n; ++i) {
+        double acc[Lanes];
+        for (int l = 0; l < Lanes; ++l) {
+            acc[l] = b[i * Lanes + l];
+        }
+        const double* aRow = a + i * n * Lanes;
+        for (int j = 0; j < n; ++j) {
+            subtractLanes(aRow + j * Lanes, xOld + j * Lanes, acc);
+        }
+        for (int l = 0; l < Lanes; ++l) {
+            xNew[i * Lanes + l] = acc[l];
+        }
+    }
+}
+
+template <std::size_t... N>
+constexpr std::array<SweepFunction, sizeof...(N)> makeSweepTable(std::index_sequence<N...>)
+{
+    return {{ &FixedSweep<int(N) + MinSpecializedSize>::run... }};
+}
+
+/**
+ * @brief Picks the kernel for packs of size n.
+ *
+ * @param n The size of the systems in the pack.
+ * @return The specialized kernel for 2 <= n <= 32, the generic kernel otherwise.
+ */
+inline SweepFunction sweepFor(int n)
+{
+    static constexpr auto table =
+        makeSweepTable(std::make_index_sequence<MaxSpecializedSize - MinSpecializedSize + 1>());
+
+    if (n >= MinSpecializedSize && n <= MaxSpecializedSize) {
+        return table[n - MinSpecializedSize];
+    }
+    return &genericSweep;
+}
+
+} // namespace SmallSystemKernel
+
+#endif // SMALLSYSTEMKERNEL_H